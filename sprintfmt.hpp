@@ -1,5 +1,9 @@
 ﻿#pragma once
 
+#if defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace sprintfmt
 {
 #if 0
@@ -112,6 +116,19 @@ namespace sprintfmt
 		inline static const std::string suffix_f = "f";
 		inline static const std::string fmt_p32 = "0x%08X";
 		inline static const std::string fmt_p64 = "0x%016llX";
+		inline static const std::string sub_fmt_csv = "csv";
+		inline static const std::string sub_fmt_tsv = "tsv";
+		inline static const std::string sub_fmt_json = "json";
+		inline static const std::string sub_fmt_hex = "x";
+		inline static const std::string sub_fmt_hex_upper = "X";
+		inline static const std::string sub_fmt_spaced_hex = "xs";
+		inline static const std::string sub_fmt_spaced_hex_upper = "Xs";
+		inline static const std::string sub_fmt_dump = "dump";
+		inline static const std::string sub_fmt_base64 = "base64";
+		inline static const std::string sub_fmt_iso = "iso";
+		inline static const std::string sub_fmt_date = "date";
+		inline static const std::string sub_fmt_time = "time";
+		inline static const std::string fmt_date = "%04d-%02u-%02u";
 		inline static constexpr const std::string& from_hs(const std::string& value) { return value; }
 		inline static std::string from_ls(const std::wstring& value) { return from_wide(value); }
 		inline static std::string::size_type strlen(const std::string::value_type* s) { return ::strlen(s); }
@@ -139,6 +156,19 @@ namespace sprintfmt
 		inline static const std::wstring suffix_f = L"f";
 		inline static const std::wstring fmt_p32 = L"0x%08X";
 		inline static const std::wstring fmt_p64 = L"0x%016llX";
+		inline static const std::wstring sub_fmt_csv = L"csv";
+		inline static const std::wstring sub_fmt_tsv = L"tsv";
+		inline static const std::wstring sub_fmt_json = L"json";
+		inline static const std::wstring sub_fmt_hex = L"x";
+		inline static const std::wstring sub_fmt_hex_upper = L"X";
+		inline static const std::wstring sub_fmt_spaced_hex = L"xs";
+		inline static const std::wstring sub_fmt_spaced_hex_upper = L"Xs";
+		inline static const std::wstring sub_fmt_dump = L"dump";
+		inline static const std::wstring sub_fmt_base64 = L"base64";
+		inline static const std::wstring sub_fmt_iso = L"iso";
+		inline static const std::wstring sub_fmt_date = L"date";
+		inline static const std::wstring sub_fmt_time = L"time";
+		inline static const std::wstring fmt_date = L"%04d-%02u-%02u";
 		inline static std::wstring from_hs(const std::string& value) { return to_wide(value); }
 		inline static constexpr const std::wstring& from_ls(const std::wstring& value) { return value; }
 		inline static std::wstring::size_type strlen(const std::wstring::value_type* s) { return ::wcslen(s); }
@@ -183,10 +213,520 @@ namespace sprintfmt
 	}
 
 	//
-	// T型の値をS型の文字列に変換して返します。
+	// この構造体はCSV、TSV、JSON用に文字列をエスケープして追加します。
+	//
+	template <typename S>
+	struct Escaper
+	{
+		//
+		// 文字の型です。
+		//
+		using char_type = typename S::value_type;
+
+		//
+		// エスケープの種類です。
+		//
+		enum class Kind { none, csv, tsv, json };
+
+		//
+		// サブフォーマットに対応するエスケープの種類を返します。
+		//
+		inline static Kind to_kind(const S& fmt)
+		{
+			using utils = Utils<S>;
+
+			if (fmt == utils::sub_fmt_csv) return Kind::csv;
+			if (fmt == utils::sub_fmt_tsv) return Kind::tsv;
+			if (fmt == utils::sub_fmt_json) return Kind::json;
+
+			return Kind::none;
+		}
+
+		//
+		// 指定された文字がエスケープ対象の場合はtrueを返します。
+		//
+		inline static constexpr bool is_special(Kind kind, char_type c)
+		{
+			switch (kind)
+			{
+			case Kind::csv: return c == '"' || c == ',' || c == '\r' || c == '\n';
+			case Kind::tsv: return c == '\t' || c == '\n' || c == '\r' || c == '\\';
+			case Kind::json: return c == '"' || c == '\\' || (c >= 0 && c < 0x20);
+			}
+
+			return false;
+		}
+
+		//
+		// エスケープ対象の文字を検索して、その位置を返します。
+		// find_mb_lead_byteがtrueの場合はマルチバイト文字の先頭バイトでも停止します。
+		//
+		inline static const char_type* find_special(Kind kind, const char_type* p, const char_type* end, bool find_mb_lead_byte)
+		{
+#if defined(_M_IX86) || defined(_M_X64)
+			if constexpr (sizeof(char_type) == 1 || sizeof(char_type) == 2)
+			{
+				// 比較対象の文字です。
+				// 制御文字はまとめて判定します。
+				auto splat = [](char_type c) {
+					if constexpr (sizeof(char_type) == 1)
+						return _mm_set1_epi8((char)c);
+					else
+						return _mm_set1_epi16((short)c);
+				};
+				const auto quote = splat('"'), comma = splat(','), cr = splat('\r'), lf = splat('\n');
+				const auto tab = splat('\t'), backslash = splat('\\');
+				const auto zero = _mm_setzero_si128(), max_control = splat(0x1F);
+
+				// 1回の比較で処理する文字数です。
+				constexpr auto c_count = (ptrdiff_t)(16 / sizeof(char_type));
+
+				for (; end - p >= c_count; p += c_count)
+				{
+					auto v = _mm_loadu_si128((const __m128i*)p);
+					auto eq = [&](__m128i a, __m128i b) {
+						if constexpr (sizeof(char_type) == 1)
+							return _mm_cmpeq_epi8(a, b);
+						else
+							return _mm_cmpeq_epi16(a, b);
+					};
+
+					auto mask = zero;
+					switch (kind)
+					{
+					case Kind::csv:
+						mask = _mm_or_si128(_mm_or_si128(eq(v, quote), eq(v, comma)), _mm_or_si128(eq(v, cr), eq(v, lf)));
+						break;
+					case Kind::tsv:
+						mask = _mm_or_si128(_mm_or_si128(eq(v, tab), eq(v, backslash)), _mm_or_si128(eq(v, cr), eq(v, lf)));
+						break;
+					case Kind::json:
+						// v <= 0x1Fの場合はvから0x1Fを飽和減算すると0になります。
+						if constexpr (sizeof(char_type) == 1)
+							mask = eq(_mm_subs_epu8(v, max_control), zero);
+						else
+							mask = eq(_mm_subs_epu16(v, max_control), zero);
+						mask = _mm_or_si128(mask, _mm_or_si128(eq(v, quote), eq(v, backslash)));
+						break;
+					}
+
+					auto bits = (unsigned long)_mm_movemask_epi8(mask);
+
+					// マルチバイト文字の先頭バイトは最上位ビットが立っています。
+					if constexpr (sizeof(char_type) == 1)
+						if (find_mb_lead_byte) bits |= (unsigned long)_mm_movemask_epi8(v);
+
+					auto index = 0ul;
+					if (_BitScanForward(&index, bits))
+						return p + index / sizeof(char_type);
+				}
+			}
+#endif
+			// 残りの文字を1文字ずつ判定します。
+			for (; p < end; p++)
+			{
+				if (is_special(kind, *p)) break;
+
+				if constexpr (sizeof(char_type) == 1)
+					if (find_mb_lead_byte && (unsigned char)*p >= 0x80) break;
+			}
+
+			return p;
+		}
+
+		//
+		// エスケープ対象の文字をエスケープして追加します。
+		//
+		inline static void append_escaped_char(S& out, Kind kind, char_type c)
+		{
+			// エスケープシーケンスを追加します。
+			auto append_escape = [&](char_type c) { out += char_type('\\'); out += c; };
+
+			switch (kind)
+			{
+			case Kind::csv:
+				{
+					// 引用符は二重にします。
+					if (c == '"') out += c;
+					out += c;
+					break;
+				}
+			case Kind::tsv:
+				{
+					switch (c)
+					{
+					case '\t': append_escape('t'); break;
+					case '\n': append_escape('n'); break;
+					case '\r': append_escape('r'); break;
+					default: append_escape(c); break;
+					}
+					break;
+				}
+			case Kind::json:
+				{
+					switch (c)
+					{
+					case '"': append_escape('"'); break;
+					case '\\': append_escape('\\'); break;
+					case '\b': append_escape('b'); break;
+					case '\f': append_escape('f'); break;
+					case '\t': append_escape('t'); break;
+					case '\n': append_escape('n'); break;
+					case '\r': append_escape('r'); break;
+					default:
+						{
+							// その他の制御文字は\u00XXの形式にします。
+							const auto hex = "0123456789abcdef";
+							append_escape('u');
+							out += char_type('0');
+							out += char_type('0');
+							out += char_type(hex[(c >> 4) & 0x0F]);
+							out += char_type(hex[c & 0x0F]);
+							break;
+						}
+					}
+					break;
+				}
+			}
+		}
+
+		//
+		// 指定された文字列をエスケープして追加します。
+		//
+		inline static void append(S& out, Kind kind, const char_type* begin, const char_type* end)
+		{
+			// マルチバイト文字の後続バイトが'\\'と一致する場合があるので、
+			// '\\'をエスケープする場合はマルチバイト文字を1文字ずつ処理します。
+			// CSVの対象文字は後続バイトと一致しないので、その必要はありません。
+			auto find_mb_lead_byte = false;
+			if constexpr (sizeof(char_type) == 1)
+				find_mb_lead_byte = kind != Kind::csv && MB_CUR_MAX > 1;
+
+			// CSVの場合は
+			if (kind == Kind::csv)
+			{
+				// エスケープ対象の文字が存在しない場合はそのまま追加します。
+				if (find_special(kind, begin, end, false) == end)
+					return (void)out.append(begin, end);
+
+				// 引用符で囲みます。
+				out += char_type('"');
+			}
+
+			for (auto p = begin; p < end;)
+			{
+				// エスケープ対象の文字までをそのまま追加します。
+				auto q = find_special(kind, p, end, find_mb_lead_byte);
+				out.append(p, q);
+				if (q >= end) break;
+
+				// マルチバイト文字の場合は
+				if (!is_special(kind, *q))
+				{
+					// find_str()と同様に文字の長さを取得します。
+					auto mb_state = mbstate_t {};
+					auto char_length = (int)mbrlen((const char*)q, (size_t)(end - q), &mb_state);
+
+					// 文字の長さが取得できなかった場合は1バイトとして扱います。
+					if (char_length < 1) char_length = 1;
+
+					// 文字をそのまま追加します。
+					out.append(q, q + char_length);
+					p = q + char_length;
+				}
+				// エスケープ対象の文字の場合は
+				else
+				{
+					// エスケープして追加します。
+					append_escaped_char(out, kind, *q);
+					p = q + 1;
+				}
+			}
+
+			// CSVの場合は引用符で閉じます。
+			if (kind == Kind::csv)
+				out += char_type('"');
+		}
+
+		//
+		// 指定された文字列をエスケープして追加します。
+		//
+		inline static void append(S& out, Kind kind, const S& value)
+		{
+			append(out, kind, value.data(), value.data() + value.length());
+		}
+	};
+
+	//
+	// この構造体は文字列を表示幅で揃えます。
+	// 全角文字の幅は2、結合文字などの幅は0として計算します。
+	//
+	template <typename S>
+	struct Aligner
+	{
+		//
+		// 文字の型です。
+		//
+		using char_type = typename S::value_type;
+
+		//
+		// この構造体はサブフォーマットを解析した結果です。
+		//
+		struct Spec
+		{
+			// 揃え方です。'<'、'>'、'^'のいずれかです。
+			char_type align;
+
+			// 揃える表示幅です。
+			size_t width;
+
+			// 最大の表示幅です。
+			// c_no_limitの場合は切り詰めません。
+			size_t max_width;
+		};
+
+		//
+		// 最大の表示幅が指定されていないことを表します。
+		//
+		inline static constexpr size_t c_no_limit = (size_t)-1;
+
+		//
+		// 幅が0の文字の範囲です。
+		//
+		inline static constexpr char32_t c_zero_width_ranges[][2] = {
+			{ 0x0300, 0x036F }, { 0x0483, 0x0489 }, { 0x0591, 0x05BD }, { 0x0610, 0x061A },
+			{ 0x064B, 0x065F }, { 0x1AB0, 0x1AFF }, { 0x1DC0, 0x1DFF }, { 0x200B, 0x200F },
+			{ 0x202A, 0x202E }, { 0x2060, 0x2064 }, { 0x20D0, 0x20FF }, { 0x302A, 0x302D },
+			{ 0x3099, 0x309A }, { 0xFE00, 0xFE0F }, { 0xFE20, 0xFE2F }, { 0xFEFF, 0xFEFF },
+			{ 0xE0001, 0xE007F }, { 0xE0100, 0xE01EF },
+		};
+
+		//
+		// 全角(East Asian WidthがWまたはF)の文字の範囲です。
+		//
+		inline static constexpr char32_t c_wide_ranges[][2] = {
+			{ 0x1100, 0x115F }, { 0x231A, 0x231B }, { 0x2329, 0x232A }, { 0x23E9, 0x23EC },
+			{ 0x23F0, 0x23F0 }, { 0x23F3, 0x23F3 }, { 0x25FD, 0x25FE }, { 0x2614, 0x2615 },
+			{ 0x2648, 0x2653 }, { 0x267F, 0x267F }, { 0x2693, 0x2693 }, { 0x26A1, 0x26A1 },
+			{ 0x26AA, 0x26AB }, { 0x26BD, 0x26BE }, { 0x26C4, 0x26C5 }, { 0x26CE, 0x26CE },
+			{ 0x26D4, 0x26D4 }, { 0x26EA, 0x26EA }, { 0x26F2, 0x26F3 }, { 0x26F5, 0x26F5 },
+			{ 0x26FA, 0x26FA }, { 0x26FD, 0x26FD }, { 0x2705, 0x2705 }, { 0x270A, 0x270B },
+			{ 0x2728, 0x2728 }, { 0x274C, 0x274C }, { 0x274E, 0x274E }, { 0x2753, 0x2755 },
+			{ 0x2757, 0x2757 }, { 0x2795, 0x2797 }, { 0x27B0, 0x27B0 }, { 0x27BF, 0x27BF },
+			{ 0x2B1B, 0x2B1C }, { 0x2B50, 0x2B50 }, { 0x2B55, 0x2B55 }, { 0x2E80, 0x303E },
+			{ 0x3041, 0x33FF }, { 0x3400, 0x4DBF }, { 0x4E00, 0x9FFF }, { 0xA000, 0xA4CF },
+			{ 0xA960, 0xA97F }, { 0xAC00, 0xD7A3 }, { 0xF900, 0xFAFF }, { 0xFE10, 0xFE19 },
+			{ 0xFE30, 0xFE6F }, { 0xFF00, 0xFF60 }, { 0xFFE0, 0xFFE6 }, { 0x16FE0, 0x16FE4 },
+			{ 0x17000, 0x18CFF }, { 0x1B000, 0x1B2FF }, { 0x1F004, 0x1F004 }, { 0x1F0CF, 0x1F0CF },
+			{ 0x1F18E, 0x1F18E }, { 0x1F191, 0x1F19A }, { 0x1F200, 0x1F202 }, { 0x1F210, 0x1F23B },
+			{ 0x1F240, 0x1F248 }, { 0x1F250, 0x1F251 }, { 0x1F260, 0x1F265 }, { 0x1F300, 0x1F320 },
+			{ 0x1F32D, 0x1F335 }, { 0x1F337, 0x1F37C }, { 0x1F37E, 0x1F393 }, { 0x1F3A0, 0x1F3CA },
+			{ 0x1F3CF, 0x1F3D3 }, { 0x1F3E0, 0x1F3F0 }, { 0x1F3F4, 0x1F3F4 }, { 0x1F3F8, 0x1F43E },
+			{ 0x1F440, 0x1F440 }, { 0x1F442, 0x1F4FC }, { 0x1F4FF, 0x1F53D }, { 0x1F54B, 0x1F54E },
+			{ 0x1F550, 0x1F567 }, { 0x1F57A, 0x1F57A }, { 0x1F595, 0x1F596 }, { 0x1F5A4, 0x1F5A4 },
+			{ 0x1F5FB, 0x1F64F }, { 0x1F680, 0x1F6C5 }, { 0x1F6CC, 0x1F6CC }, { 0x1F6D0, 0x1F6D2 },
+			{ 0x1F6D5, 0x1F6D7 }, { 0x1F6DC, 0x1F6DF }, { 0x1F6EB, 0x1F6EC }, { 0x1F6F4, 0x1F6FC },
+			{ 0x1F7E0, 0x1F7EB }, { 0x1F7F0, 0x1F7F0 }, { 0x1F90C, 0x1F93A }, { 0x1F93C, 0x1F945 },
+			{ 0x1F947, 0x1F9FF }, { 0x1FA70, 0x1FAFF }, { 0x20000, 0x2FFFD }, { 0x30000, 0x3FFFD },
+		};
+
+		//
+		// サロゲートペアになる文字の幅を判定できない場合に使用する文字コードです。
+		// 補助面の文字の多くは全角なので全角の範囲の文字コードにしています。
+		//
+		inline static constexpr char32_t c_unknown_supplementary = 0x20000;
+
+		//
+		// 指定された文字が範囲の配列に含まれる場合はtrueを返します。
+		//
+		template <size_t N>
+		inline static constexpr bool contains(const char32_t (&ranges)[N][2], char32_t c)
+		{
+			// 範囲の配列は昇順に並んでいるので二分探索します。
+			size_t lower = 0, upper = N;
+			while (lower < upper)
+			{
+				auto middle = (lower + upper) / 2;
+
+				if (c < ranges[middle][0]) upper = middle;
+				else if (c > ranges[middle][1]) lower = middle + 1;
+				else return true;
+			}
+
+			return false;
+		}
+
+		//
+		// 指定された文字の表示幅を返します。
+		//
+		inline static constexpr size_t get_char_width(char32_t c)
+		{
+			// よく使用される文字は表を検索せずに判定します。
+			if (c < 0x0300) return 1;
+			if (c >= 0x4E00 && c <= 0x9FFF) return 2;
+
+			if (contains(c_zero_width_ranges, c)) return 0;
+			if (contains(c_wide_ranges, c)) return 2;
+
+			return 1;
+		}
+
+		//
+		// サブフォーマットを解析して結果を返します。
+		// "w"の後に揃え方、表示幅、"."と最大の表示幅を指定します。
+		// 表示幅用のサブフォーマットではない場合はfalseを返します。
+		//
+		inline static bool parse(const S& fmt, Spec& spec)
+		{
+			auto p = fmt.c_str(), end = p + fmt.length();
+
+			if (p == end || *p++ != 'w') return false;
+
+			spec = Spec { char_type('<'), 0, c_no_limit };
+
+			// 揃え方を取得します。
+			if (p < end && (*p == '<' || *p == '>' || *p == '^'))
+				spec.align = *p++;
+
+			// 数字を読み込みます。
+			auto read_number = [&](size_t& value) {
+				auto begin = p;
+				for (value = 0; p < end && *p >= '0' && *p <= '9'; p++)
+					value = value * 10 + (*p - '0');
+				return p != begin;
+			};
+
+			// 表示幅を取得します。
+			read_number(spec.width);
+
+			// 最大の表示幅を取得します。
+			if (p < end && *p == '.')
+			{
+				p++;
+
+				if (!read_number(spec.max_width)) return false;
+			}
+
+			return p == end;
+		}
+
+		//
+		// 文字の長さを返し、文字コードを取得します。
+		// find_str()と同様にマルチバイト文字は1文字ずつ処理します。
+		//
+		inline static size_t next_char(const char_type* p, const char_type* end, mbstate_t& mb_state, char32_t& c)
+		{
+			if constexpr (sizeof(char_type) == 1)
+			{
+				// ASCII文字の場合はそのまま返します。
+				if ((unsigned char)*p < 0x80) { c = (unsigned char)*p; return 1; }
+
+				auto wc = wchar_t {};
+				auto char_length = (int)mbrtowc(&wc, p, (size_t)(end - p), &mb_state);
+
+				// 文字の長さが取得できなかった場合は1バイトの文字として扱います。
+				if (char_length < 1)
+				{
+					mb_state = mbstate_t {};
+					c = (unsigned char)*p;
+					return 1;
+				}
+
+				// ワイド文字がサロゲートになる場合は文字コードが分からないので
+				// 補助面の文字として扱います。
+				if (wc >= 0xD800 && wc <= 0xDFFF)
+					c = c_unknown_supplementary;
+				else
+					c = (char32_t)wc;
+
+				return (size_t)char_length;
+			}
+			else
+			{
+				c = (char32_t)*p;
+
+				// サロゲートペアの場合は結合します。
+				if constexpr (sizeof(char_type) == 2)
+				{
+					if (c >= 0xD800 && c <= 0xDBFF && end - p >= 2 && p[1] >= 0xDC00 && p[1] <= 0xDFFF)
+					{
+						c = 0x10000 + ((c - 0xD800) << 10) + ((char32_t)p[1] - 0xDC00);
+						return 2;
+					}
+				}
+
+				return 1;
+			}
+		}
+
+		//
+		// 出力先のpos以降の文字列を表示幅で揃えます。
+		// 最大の表示幅を超える場合は文字の境界で切り詰めます。
+		//
+		inline static void align(S& out, size_t pos, const Spec& spec)
+		{
+			auto begin = out.data() + pos, end = out.data() + out.length();
+			auto mb_state = mbstate_t {};
+			auto width = size_t {};
+
+			// 文字毎に表示幅を加算します。
+			for (auto p = begin; p < end;)
+			{
+				auto c = char32_t {};
+				auto char_length = next_char(p, end, mb_state, c);
+				auto char_width = get_char_width(c);
+
+				// 最大の表示幅を超える場合は
+				if (spec.max_width != c_no_limit && width + char_width > spec.max_width)
+				{
+					// この文字の手前で切り詰めます。
+					out.resize(pos + (size_t)(p - begin));
+					break;
+				}
+
+				width += char_width;
+				p += char_length;
+			}
+
+			if (width >= spec.width) return;
+
+			// 足りない表示幅を空白で埋めます。
+			auto padding = spec.width - width;
+			switch (spec.align)
+			{
+			case '>':
+				out.insert(pos, padding, char_type(' '));
+				break;
+			case '^':
+				out.insert(pos, padding / 2, char_type(' '));
+				out.append(padding - padding / 2, char_type(' '));
+				break;
+			default:
+				out.append(padding, char_type(' '));
+				break;
+			}
+		}
+	};
+
+	//
+	// C言語のsprintf()を使用して文字列をフォーマット化して追加します。
+	//
+	template <size_t c_max_size = 64, typename S, typename... Args>
+	constexpr void sprintf_append_S(S& out, const S& fmt, Args&&... args)
+	{
+		using utils = Utils<S>;
+
+		auto pos = out.length();
+		out.resize(pos + c_max_size, utils::eos);
+		utils::sprintf(out.data() + pos, c_max_size, fmt.c_str(), args...);
+		out.resize(pos + utils::strlen(out.data() + pos));
+	}
+
+	//
+	// T型の値をS型の文字列に変換して追加します。
 	//
 	template <typename S, typename T>
-	_NODISCARD constexpr auto fmt_value_to_string_S(const S& fmt, const T& value, auto... args) -> S
+	constexpr void fmt_value_append_S(S& out, const S& fmt, const T& value, auto... args)
 	{
 		using utils = Utils<S>;
 
@@ -194,17 +734,61 @@ namespace sprintfmt
 		// 指定されている書式を使用します。
 		if (fmt.length())
 		{
-			if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::wstring>)
+			using escaper = Escaper<S>;
+
+			// エスケープ用のサブフォーマットが指定されている場合は
+			if (auto kind = escaper::to_kind(fmt); kind != escaper::Kind::none)
+			{
+				if constexpr (std::is_convertible_v<T, const char*> || std::is_convertible_v<T, const wchar_t*>)
+				{
+					if constexpr (std::is_pointer_v<T>)
+						if (!value) { out += utils::null_pointer; return; }
+
+					// 文字列の型が一致する場合は直接エスケープします。
+					if constexpr (std::is_convertible_v<T, const typename S::value_type*>)
+					{
+						const typename S::value_type* s = value;
+						escaper::append(out, kind, s, s + utils::strlen(s));
+					}
+					else if constexpr (std::is_convertible_v<T, const char*>)
+						escaper::append(out, kind, utils::from_hs(value));
+					else
+						escaper::append(out, kind, utils::from_ls(value));
+				}
+				else if constexpr (std::is_same_v<T, std::string>)
+				{
+					escaper::append(out, kind, utils::from_hs(value));
+				}
+				else if constexpr (std::is_same_v<T, std::wstring>)
+				{
+					escaper::append(out, kind, utils::from_ls(value));
+				}
+				else
+				{
+					// 文字列以外の値はエスケープの必要がないので
+					// デフォルトの書式で文字列化します。
+					fmt_value_append_S<S, T>(out, S {}, value, args...);
+				}
+			}
+			// 表示幅用のサブフォーマットが指定されている場合は
+			else if (auto spec = typename Aligner<S>::Spec {}; Aligner<S>::parse(fmt, spec))
+			{
+				// デフォルトの書式で文字列化してから表示幅を揃えます。
+				auto pos = out.length();
+				fmt_value_append_S<S, T>(out, S {}, value, args...);
+				Aligner<S>::align(out, pos, spec);
+			}
+			else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::wstring>)
 			{
-				return sprintf<2048>(utils::prefix + fmt, args..., value.c_str());
+				sprintf_append_S<2048>(out, utils::prefix + fmt, args..., value.c_str());
 			}
 			else if constexpr(std::is_convertible_v<T, const char*> || std::is_convertible_v<T, const wchar_t*>)
 			{
-				return sprintf<2048>(utils::prefix + fmt, args..., value);
+				sprintf_append_S<2048>(out, utils::prefix + fmt, args..., value);
 			}
 			else
 			{
-				return sprintf(utils::prefix + fmt, args..., value);
+				sprintf_append_S(out, utils::prefix + fmt, args..., value);
 			}
 		}
 		// サブフォーマットが指定されていない場合は
@@ -214,52 +798,58 @@ namespace sprintfmt
 			if constexpr (std::is_convertible_v<T, const char*>)
 			{
 				if constexpr (std::is_pointer_v<T>)
-					return value ? utils::from_hs(value) : utils::null_pointer;
+					if (!value) { out += utils::null_pointer; return; }
+
+				if constexpr (std::is_same_v<S, std::string>)
+					out += value;
 				else
-					return utils::from_hs(value);
+					out += utils::from_hs(value);
 			}
 			else if constexpr (std::is_convertible_v<T, const wchar_t*>)
 			{
 				if constexpr (std::is_pointer_v<T>)
-					return value ? utils::from_ls(value) : utils::null_pointer;
+					if (!value) { out += utils::null_pointer; return; }
+
+				if constexpr (std::is_same_v<S, std::wstring>)
+					out += value;
 				else
-					return utils::from_ls(value);
+					out += utils::from_ls(value);
 			}
 			else if constexpr (std::is_same_v<T, std::string>)
 			{
-				return utils::from_hs(value);
+				out += utils::from_hs(value);
 			}
 			else if constexpr (std::is_same_v<T, std::wstring>)
 			{
-				return utils::from_ls(value);
+				out += utils::from_ls(value);
 			}
 			else if constexpr(std::is_integral_v<T>)
 			{
 				if constexpr(std::is_signed_v<T>)
 				{
 					if constexpr(sizeof(T) <= 4)
-						return sprintf(utils::prefix + fmt + utils::suffix_d32, args..., value);
+						sprintf_append_S(out, utils::prefix + fmt + utils::suffix_d32, args..., value);
 					else
-						return sprintf(utils::prefix + fmt + utils::suffix_d64, args..., value);
+						sprintf_append_S(out, utils::prefix + fmt + utils::suffix_d64, args..., value);
 				}
 				else
 				{
 					if constexpr(sizeof(T) <= 4)
-						return sprintf(utils::prefix + fmt + utils::suffix_u32, args..., value);
+						sprintf_append_S(out, utils::prefix + fmt + utils::suffix_u32, args..., value);
 					else
-						return sprintf(utils::prefix + fmt + utils::suffix_u64, args..., value);
+						sprintf_append_S(out, utils::prefix + fmt + utils::suffix_u64, args..., value);
 				}
 			}
 			else if constexpr(std::is_floating_point_v<T>)
 			{
-				return sprintf(utils::prefix + fmt + utils::suffix_f, args..., value);
+				sprintf_append_S(out, utils::prefix + fmt + utils::suffix_f, args..., value);
 			}
 			else if constexpr(std::is_pointer_v<T> || std::is_enum_v<T>)
 			{
 				if constexpr(sizeof(T) <= 4)
-					return sprintf(utils::fmt_p32, args..., value);
+					sprintf_append_S(out, utils::fmt_p32, args..., value);
 				else
-					return sprintf(utils::fmt_p64, args..., value);
+					sprintf_append_S(out, utils::fmt_p64, args..., value);
 			}
 			else
 			{
@@ -268,360 +858,2313 @@ namespace sprintfmt
 		}
 	}
 
+	//
+	// T型の値をS型の文字列に変換して返します。
+	//
+	template <typename S, typename T>
+	_NODISCARD constexpr auto fmt_value_to_string_S(const S& fmt, const T& value, auto... args) -> S
+	{
+		auto s = S {};
+		fmt_value_append_S<S, T>(s, fmt, value, args...);
+		return s;
+	}
+
+	//
+	// 指定された値を文字列化して追加します。
+	// fmt_value_append()が見つかる場合はそれを使用し、
+	// 見つからない場合は組み込みの型として文字列化します。
+	// 後から定義されるfmt_value_append()も見つけられるように、定義はファイルの後方にあります。
+	//
+	template <typename S, typename T>
+	constexpr void fmt_value_append_or_builtin_S(S& out, const S& fmt, const T& value, auto... args);
+
 	//
 	// 指定された値をstd::stringに変換して返します。
+	// fmt_value_append()だけが定義されている型も変換できます。
 	//
 	template <typename T>
 	_NODISCARD constexpr auto fmt_value_to_string(const std::string& fmt, const T& value, auto... args) -> std::string
 	{
-		return fmt_value_to_string_S<std::string, T>(fmt, value, args...);
+		auto s = std::string {};
+		fmt_value_append_or_builtin_S(s, fmt, value, args...);
+		return s;
 	}
 
 	//
-	// 指定された値をstd::stringに変換して返します。
+	// 指定された値をstd::wstringに変換して返します。
+	// fmt_value_append()だけが定義されている型も変換できます。
 	//
 	template <typename T>
 	_NODISCARD constexpr auto fmt_value_to_string(const std::wstring& fmt, const T& value, auto... args) -> std::wstring
 	{
-		return fmt_value_to_string_S<std::wstring, T>(fmt, value, args...);
+		auto s = std::wstring {};
+		fmt_value_append_or_builtin_S(s, fmt, value, args...);
+		return s;
 	}
-#ifdef _FILESYSTEM_
+
 	//
-	// std::filesystem::pathをstd::stringに変換します。
+	// この概念はfmt_value_append()が組み込みで対応している型です。
+	// 列挙型はユーザーがfmt_value_to_string()を定義できるように除外しています。
 	//
-	_NODISCARD constexpr auto fmt_value_to_string(const std::string& fmt, const std::filesystem::path& value, auto... args) -> std::string
+	template <typename T>
+	concept builtin_fmt_value =
+		std::is_same_v<T, std::string> || std::is_same_v<T, std::wstring> ||
+		std::is_arithmetic_v<T> || std::is_pointer_v<T> ||
+		(std::is_array_v<T> && (std::is_convertible_v<T, const char*> || std::is_convertible_v<T, const wchar_t*>));
+
+	//
+	// 指定された値をstd::stringに変換して追加します。
+	//
+	template <builtin_fmt_value T>
+	constexpr void fmt_value_append(std::string& out, const std::string& fmt, const T& value, auto... args)
 	{
-		return fmt_value_to_string(fmt, value.string(), args...);
+		fmt_value_append_S<std::string, T>(out, fmt, value, args...);
 	}
 
 	//
-	// std::filesystem::pathをstd::wstringに変換します。
+	// 指定された値をstd::wstringに変換して追加します。
 	//
-	_NODISCARD constexpr auto fmt_value_to_string(const std::wstring& fmt, const std::filesystem::path& value, auto... args) -> std::wstring
+	template <builtin_fmt_value T>
+	constexpr void fmt_value_append(std::wstring& out, const std::wstring& fmt, const T& value, auto... args)
+	{
+		fmt_value_append_S<std::wstring, T>(out, fmt, value, args...);
+	}
+#ifdef _FILESYSTEM_
+	//
+	// std::filesystem::pathをstd::stringに変換します。
+	//
+	_NODISCARD constexpr auto fmt_value_to_string(const std::string& fmt, const std::filesystem::path& value, auto... args) -> std::string
+	{
+		return fmt_value_to_string(fmt, value.string(), args...);
+	}
+
+	//
+	// std::filesystem::pathをstd::wstringに変換します。
+	//
+	_NODISCARD constexpr auto fmt_value_to_string(const std::wstring& fmt, const std::filesystem::path& value, auto... args) -> std::wstring
 	{
 		return fmt_value_to_string(fmt, value.wstring(), args...);
 	}
-#endif
+
 	//
-	// この構造体はヘルパーです。
+	// std::filesystem::pathをstd::stringに変換して追加します。
 	//
-	template <typename S> struct Helper;
+	constexpr void fmt_value_append(std::string& out, const std::string& fmt, const std::filesystem::path& value, auto... args)
+	{
+		fmt_value_append(out, fmt, value.string(), args...);
+	}
 
 	//
-	// この構造体はstd::string型に特殊化されたヘルパーです。
+	// std::filesystem::pathをstd::wstringに変換して追加します。
 	//
-	template <> struct Helper<std::string>
+	constexpr void fmt_value_append(std::wstring& out, const std::wstring& fmt, const std::filesystem::path& value, auto... args)
+	{
+		fmt_value_append(out, fmt, value.wstring(), args...);
+	}
+#endif
+#ifdef _SPAN_
+	//
+	// この構造体はバイト列を文字列化します。
+	// 出力先の文字列を先に伸ばしてから直接書き込みます。
+	//
+	template <typename S>
+	struct ByteEncoder
 	{
 		//
-		// フォーマット用のキーワードです。
+		// 文字の型です。
 		//
-		inline static constexpr struct {
-			inline static const std::string begin = "{/";
-			inline static const std::string end = "}";
-			inline static const std::string escape = "/";
-			inline static const std::string separator = "$";
-			inline static const std::string invalid_arg_index = "invalid_arg_index";
-		} keyword;
+		using char_type = typename S::value_type;
 
 		//
-		// 指定された文字列の出現位置を返します。
+		// 文字列化の種類です。
 		//
-		inline static const std::string::value_type* find_str(
-			const std::string::value_type* str_begin,
-			const std::string::value_type* str_end,
-			const std::string& pattern)
+		enum class Kind { none, hex, hex_upper, spaced_hex, spaced_hex_upper, dump, base64 };
+
+		//
+		// ダンプの1行あたりのバイト数です。
+		//
+		inline static constexpr size_t c_dump_row_size = 16;
+
+		//
+		// サブフォーマットに対応する文字列化の種類を返します。
+		// サブフォーマットが指定されていない場合は大文字の16進数になります。
+		// 対応していないサブフォーマットの場合はKind::noneを返します。
+		//
+		inline static Kind to_kind(const S& fmt)
 		{
-			// 文字列が無効の場合は失敗します。
-			if (str_begin >= str_end) return nullptr;
+			using utils = Utils<S>;
 
-			// パターンが無効の場合は失敗します。
-			if (pattern.empty()) return nullptr;
+			if (fmt.empty() || fmt == utils::sub_fmt_hex_upper) return Kind::hex_upper;
+			if (fmt == utils::sub_fmt_hex) return Kind::hex;
+			if (fmt == utils::sub_fmt_spaced_hex) return Kind::spaced_hex;
+			if (fmt == utils::sub_fmt_spaced_hex_upper) return Kind::spaced_hex_upper;
+			if (fmt == utils::sub_fmt_dump) return Kind::dump;
+			if (fmt == utils::sub_fmt_base64) return Kind::base64;
 
-			// 文字列の長さを取得します。
-			auto str_length = (size_t)(str_end - str_begin);
+			return Kind::none;
+		}
 
-			// 文字列がパターンより短い場合はnullptrを返します。
-			if (str_length < pattern.length()) return nullptr;
+		//
+		// 文字列化した結果の長さを返します。
+		//
+		inline static constexpr size_t get_length(Kind kind, size_t size)
+		{
+			if (!size) return 0;
 
-			// mbrlen()が使用する変数です。
-			auto mb_state = mbstate_t {};
+			switch (kind)
+			{
+			case Kind::spaced_hex:
+			case Kind::spaced_hex_upper:
+				return size * 3 - 1;
+			case Kind::dump:
+				{
+					// 最後の行以外は改行を含めて一定の長さになります。
+					auto row_count = (size + c_dump_row_size - 1) / c_dump_row_size;
+					auto last_size = size - (row_count - 1) * c_dump_row_size;
+					return (row_count - 1) * (get_dump_row_length(c_dump_row_size) + 1) + get_dump_row_length(last_size);
+				}
+			case Kind::base64:
+				return (size + 2) / 3 * 4;
+			}
 
-			// 文字列の長さからパターンの長さを除いた数だけループします。
-			for (auto p = str_begin; p <= str_end - pattern.length();)
+			return size * 2;
+		}
+
+		//
+		// ダンプの1行の長さを返します。
+		// "00000000  00 01 02 03 04 05 06 07  08 09 0a 0b 0c 0d 0e 0f  |0123456789abcdef|"
+		//
+		inline static constexpr size_t get_dump_row_length(size_t size)
+		{
+			return 8 + 2 + c_dump_row_size * 3 + 1 + 2 + size + 1;
+		}
+
+		//
+		// バイト列を16進数に変換して書き込みます。
+		// 書き込んだ文字の終端を返します。
+		//
+		inline static char_type* write_hex(char_type* out, const unsigned char* p, const unsigned char* end, bool upper)
+		{
+#if defined(_M_IX86) || defined(_M_X64)
+			if constexpr (sizeof(char_type) == 1 || sizeof(char_type) == 2)
 			{
-				// 文字の長さを取得します。
-				auto char_length = (int)mbrlen(p, MB_CUR_MAX, &mb_state);
+				// 4ビットの値を16進数の文字に変換します。
+				// 9より大きい値は'0'からアルファベットまでの差を加算します。
+				const auto nibble_mask = _mm_set1_epi8(0x0F);
+				const auto nine = _mm_set1_epi8(9);
+				const auto digit_base = _mm_set1_epi8('0');
+				const auto alpha_offset = _mm_set1_epi8(char((upper ? 'A' : 'a') - '0' - 10));
+				auto to_char = [&](__m128i n) {
+					return _mm_add_epi8(_mm_add_epi8(n, digit_base), _mm_and_si128(_mm_cmpgt_epi8(n, nine), alpha_offset));
+				};
+
+				// 16バイトずつ32文字に変換します。
+				for (; end - p >= 16; p += 16, out += 32)
+				{
+					auto v = _mm_loadu_si128((const __m128i*)p);
+					auto hi = to_char(_mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask));
+					auto lo = to_char(_mm_and_si128(v, nibble_mask));
 
-				// 文字の長さが取得できなかった場合はループを終了します。
-				if (char_length < 1) break;
+					// 上位と下位の文字を交互に並べます。
+					auto first = _mm_unpacklo_epi8(hi, lo);
+					auto second = _mm_unpackhi_epi8(hi, lo);
 
-				// 文字列内の現在位置がパターンと一致した場合は
-				if (strncmp(p, pattern.c_str(), pattern.length()) == 0)
-					return p; // 一致した位置を返します。
+					if constexpr (sizeof(char_type) == 1)
+					{
+						_mm_storeu_si128((__m128i*)out, first);
+						_mm_storeu_si128((__m128i*)(out + 16), second);
+					}
+					else
+					{
+						// ワイド文字の場合は16ビットに拡張します。
+						const auto zero = _mm_setzero_si128();
+						_mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(first, zero));
+						_mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(first, zero));
+						_mm_storeu_si128((__m128i*)(out + 16), _mm_unpacklo_epi8(second, zero));
+						_mm_storeu_si128((__m128i*)(out + 24), _mm_unpackhi_epi8(second, zero));
+					}
+				}
+			}
+#endif
+			// 残りのバイトを1バイトずつ変換します。
+			const auto digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+			for (; p < end; p++)
+			{
+				*out++ = char_type(digits[*p >> 4]);
+				*out++ = char_type(digits[*p & 0x0F]);
+			}
 
-				// 文字の長さの分だけ現在位置を進めます。
-				p += char_length;
+			return out;
+		}
+
+		//
+		// バイト列を空白区切りの16進数に変換して書き込みます。
+		// 書き込んだ文字の終端を返します。
+		//
+		inline static char_type* write_spaced_hex(char_type* out, const unsigned char* p, const unsigned char* end, bool upper)
+		{
+			// 16バイトずつまとめて変換してから空白を挟んで書き込みます。
+			char_type hex[32];
+
+			for (auto first = true; p < end; )
+			{
+				auto size = end - p < 16 ? (size_t)(end - p) : 16;
+				write_hex(hex, p, p + size, upper);
+				p += size;
+
+				for (size_t i = 0; i < size; i++)
+				{
+					if (!first) *out++ = char_type(' ');
+					first = false;
+
+					*out++ = hex[i * 2 + 0];
+					*out++ = hex[i * 2 + 1];
+				}
 			}
 
-			// パターンが見つからなかったのでnullptrを返します。
-			return nullptr;
+			return out;
 		}
 
 		//
-		// 指定された文字列を整数に変換して返します。
+		// バイト列をオフセット、16進数、ASCII文字の形式でダンプして書き込みます。
+		// 書き込んだ文字の終端を返します。
 		//
-		inline static int to_int(const std::string& s)
+		inline static char_type* write_dump(char_type* out, const unsigned char* begin, const unsigned char* end)
 		{
-			try { return std::stoi(s); } catch (...) { return 0; }
+			char_type hex[c_dump_row_size * 2];
+
+			for (auto p = begin; p < end; )
+			{
+				auto size = end - p < (ptrdiff_t)c_dump_row_size ? (size_t)(end - p) : c_dump_row_size;
+
+				// 2行目以降は改行してから書き込みます。
+				if (p != begin) *out++ = char_type('\n');
+
+				// オフセットを書き込みます。
+				auto offset = (unsigned int)(p - begin);
+				const unsigned char offset_bytes[] = {
+					(unsigned char)(offset >> 24), (unsigned char)(offset >> 16),
+					(unsigned char)(offset >> 8), (unsigned char)(offset >> 0),
+				};
+				out = write_hex(out, offset_bytes, offset_bytes + 4, false);
+				*out++ = char_type(' ');
+				*out++ = char_type(' ');
+
+				// 16進数を書き込みます。
+				// 足りない部分は空白で埋めます。
+				write_hex(hex, p, p + size, false);
+				for (size_t i = 0; i < c_dump_row_size; i++)
+				{
+					if (i < size)
+					{
+						*out++ = hex[i * 2 + 0];
+						*out++ = hex[i * 2 + 1];
+					}
+					else
+					{
+						*out++ = char_type(' ');
+						*out++ = char_type(' ');
+					}
+
+					*out++ = char_type(' ');
+					if (i == c_dump_row_size / 2 - 1) *out++ = char_type(' ');
+				}
+
+				// 表示できる文字はそのまま、それ以外は'.'で書き込みます。
+				*out++ = char_type(' ');
+				*out++ = char_type('|');
+				for (size_t i = 0; i < size; i++)
+					*out++ = (p[i] >= 0x20 && p[i] < 0x7F) ? char_type(p[i]) : char_type('.');
+				*out++ = char_type('|');
+
+				p += size;
+			}
+
+			return out;
+		}
+
+		//
+		// バイト列をBase64に変換して書き込みます。
+		// 書き込んだ文字の終端を返します。
+		//
+		inline static char_type* write_base64(char_type* out, const unsigned char* p, const unsigned char* end)
+		{
+			const auto table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+			// 3バイトずつ4文字に変換します。
+			for (; end - p >= 3; p += 3)
+			{
+				auto n = (unsigned int)p[0] << 16 | (unsigned int)p[1] << 8 | p[2];
+				*out++ = char_type(table[(n >> 18) & 0x3F]);
+				*out++ = char_type(table[(n >> 12) & 0x3F]);
+				*out++ = char_type(table[(n >> 6) & 0x3F]);
+				*out++ = char_type(table[n & 0x3F]);
+			}
+
+			// 残りのバイトを変換して'='で埋めます。
+			if (auto rest = end - p)
+			{
+				auto n = (unsigned int)p[0] << 16 | (rest == 2 ? (unsigned int)p[1] << 8 : 0u);
+				*out++ = char_type(table[(n >> 18) & 0x3F]);
+				*out++ = char_type(table[(n >> 12) & 0x3F]);
+				*out++ = rest == 2 ? char_type(table[(n >> 6) & 0x3F]) : char_type('=');
+				*out++ = char_type('=');
+			}
+
+			return out;
+		}
+
+		//
+		// バイト列を指定された種類で文字列化して追加します。
+		//
+		inline static void append(S& out, Kind kind, const unsigned char* p, size_t size)
+		{
+			auto end = p + size;
+
+			// 出力先を伸ばして、伸ばした部分に直接書き込みます。
+			auto pos = out.length();
+			out.resize(pos + get_length(kind, size));
+			auto dst = out.data() + pos;
+
+			switch (kind)
+			{
+			case Kind::hex: write_hex(dst, p, end, false); break;
+			case Kind::hex_upper: write_hex(dst, p, end, true); break;
+			case Kind::spaced_hex: write_spaced_hex(dst, p, end, false); break;
+			case Kind::spaced_hex_upper: write_spaced_hex(dst, p, end, true); break;
+			case Kind::dump: write_dump(dst, p, end); break;
+			case Kind::base64: write_base64(dst, p, end); break;
+			}
+		}
+
+		//
+		// バイト列をサブフォーマットに従って文字列化して追加します。
+		//
+		inline static void append(S& out, const S& fmt, const unsigned char* p, size_t size, auto... args)
+		{
+			// バイト列用のサブフォーマットが指定されている場合は
+			if (auto kind = to_kind(fmt); kind != Kind::none)
+			{
+				append(out, kind, p, size);
+			}
+			// エスケープ用のサブフォーマットが指定されている場合は
+			else if (Escaper<S>::to_kind(fmt) != Escaper<S>::Kind::none)
+			{
+				// 16進数はエスケープの必要がないので
+				// デフォルトの書式で文字列化します。
+				append(out, Kind::hex_upper, p, size);
+			}
+			// 表示幅用のサブフォーマットが指定されている場合は
+			else if (auto spec = typename Aligner<S>::Spec {}; Aligner<S>::parse(fmt, spec))
+			{
+				// デフォルトの書式で文字列化してから表示幅を揃えます。
+				auto pos = out.length();
+				append(out, Kind::hex_upper, p, size);
+				Aligner<S>::align(out, pos, spec);
+			}
+			// それ以外のサブフォーマットの場合は
+			// 他の型と同様に1バイトずつ数値の書式化に使用します。
+			else
+			{
+				for (auto end = p + size; p < end; p++)
+					fmt_value_append_S<S, unsigned int>(out, fmt, *p, args...);
+			}
 		}
 	};
 
 	//
-	// この構造体はstd::wstring型に特殊化されたヘルパーです。
+	// この概念はバイト列として文字列化するstd::spanの要素の型です。
 	//
-	template <> struct Helper<std::wstring>
+	template <typename T>
+	concept byte_span_element =
+		std::is_same_v<std::remove_const_t<T>, std::byte> ||
+		std::is_same_v<std::remove_const_t<T>, unsigned char>;
+
+	//
+	// バイト列をstd::stringに変換して追加します。
+	//
+	template <byte_span_element T, size_t N>
+	void fmt_value_append(std::string& out, const std::string& fmt, std::span<T, N> value, auto... args)
+	{
+		ByteEncoder<std::string>::append(out, fmt, (const unsigned char*)value.data(), value.size(), args...);
+	}
+
+	//
+	// バイト列をstd::wstringに変換して追加します。
+	//
+	template <byte_span_element T, size_t N>
+	void fmt_value_append(std::wstring& out, const std::wstring& fmt, std::span<T, N> value, auto... args)
+	{
+		ByteEncoder<std::wstring>::append(out, fmt, (const unsigned char*)value.data(), value.size(), args...);
+	}
+#endif
+#ifdef _CHRONO_
+	//
+	// この構造体は時刻と経過時間を文字列化します。
+	// 時刻の日付と時分秒の部分はスレッド毎にキャッシュして
+	// 秒が変わるまで使い回します。
+	//
+	template <typename S>
+	struct TimeEncoder
 	{
 		//
-		// フォーマット用のキーワードです。
+		// 文字の型です。
 		//
-		inline static constexpr struct {
-			inline static const std::wstring begin = L"{/";
-			inline static const std::wstring end = L"}";
-			inline static const std::wstring escape = L"/";
-			inline static const std::wstring separator = L"$";
-			inline static const std::wstring invalid_arg_index = L"invalid_arg_index";
-		} keyword;
+		using char_type = typename S::value_type;
 
 		//
-		// 指定された文字列の出現位置を返します。
+		// 文字列化の種類です。
 		//
-		inline static const std::wstring::value_type* find_str(
-			const std::wstring::value_type* str_begin,
-			const std::wstring::value_type* str_end,
-			const std::wstring& pattern)
+		enum class Kind { none, iso, date, time };
+
+		//
+		// この構造体はサブフォーマットを解析した結果です。
+		//
+		struct Spec
 		{
-			// 文字列が無効の場合は失敗します。
-			if (str_begin >= str_end) return nullptr;
+			// 文字列化の種類です。
+			Kind kind;
 
-			// パターンが無効の場合は失敗します。
-			if (pattern.empty()) return nullptr;
+			// 秒未満の桁数です。
+			// 負数の場合は値の型の精度に合わせます。
+			int precision;
+		};
+
+		//
+		// この構造体は時刻の文字列のキャッシュです。
+		//
+		struct Cache
+		{
+			// キャッシュしている時刻です。
+			std::chrono::sys_seconds seconds = std::chrono::sys_seconds::min();
+			std::chrono::sys_time<std::chrono::minutes> minutes = std::chrono::sys_time<std::chrono::minutes>::min();
+			std::chrono::sys_days days = std::chrono::sys_days::min();
+
+			// "YYYY-MM-DDThh:mm:ss"形式の文字列です。
+			S text;
+
+			// 日付部分の長さです。
+			size_t date_length = 0;
+		};
+
+		//
+		// サブフォーマットを解析して返します。
+		// サブフォーマットが指定されていない場合は"iso"になります。
+		// "iso"、"time"の後に".N"で秒未満の桁数を指定できます。
+		// 対応していないサブフォーマットの場合はKind::noneを返します。
+		//
+		inline static Spec parse(const S& fmt)
+		{
+			using utils = Utils<S>;
+
+			auto spec = Spec { Kind::none, -1 };
+			auto name_length = fmt.length();
+
+			// 秒未満の桁数を取得します。
+			if (auto dot = fmt.find(char_type('.')); dot != S::npos)
+			{
+				if (dot + 2 != fmt.length() || fmt[dot + 1] < '0' || fmt[dot + 1] > '9') return spec;
+
+				spec.precision = fmt[dot + 1] - '0';
+				name_length = dot;
+			}
+
+			if (!name_length || fmt.compare(0, name_length, utils::sub_fmt_iso) == 0)
+				spec.kind = Kind::iso;
+			else if (fmt.compare(0, name_length, utils::sub_fmt_time) == 0)
+				spec.kind = Kind::time;
+			else if (fmt.compare(0, name_length, utils::sub_fmt_date) == 0)
+				spec.kind = (spec.precision < 0) ? Kind::date : Kind::none;
+
+			return spec;
+		}
+
+		//
+		// 周期を表現できる秒未満の桁数を返します。
+		//
+		template <typename Period>
+		inline static constexpr int get_default_precision()
+		{
+			auto precision = 0;
+			for (intmax_t scale = 1; scale < Period::den && precision < 9; scale *= 10)
+				precision++;
+			return precision;
+		}
+
+		//
+		// 2桁の数字を書き込みます。
+		//
+		inline static void write_2digits(char_type* p, unsigned int value)
+		{
+			p[0] = char_type('0' + value / 10);
+			p[1] = char_type('0' + value % 10);
+		}
+
+		//
+		// 0で埋めた数字を追加します。
+		//
+		inline static void append_number(S& out, unsigned long long value, int width = 1)
+		{
+			char_type digits[20];
+			auto p = digits + 20;
+			do { *--p = char_type('0' + value % 10); value /= 10; } while (value || (digits + 20 - p) < width);
+			out.append(p, digits + 20);
+		}
+
+		//
+		// ASCII文字列を追加します。
+		//
+		inline static void append_ascii(S& out, const char* s)
+		{
+			for (; *s; s++) out += char_type(*s);
+		}
+
+		//
+		// 秒未満の部分を指定された桁数で追加します。
+		//
+		inline static void append_fraction(S& out, std::chrono::nanoseconds fraction, int precision)
+		{
+			if (precision <= 0) return;
+
+			auto value = (unsigned long long)fraction.count();
+			for (auto i = precision; i < 9; i++) value /= 10;
+
+			out += char_type('.');
+			append_number(out, value, precision);
+		}
+
+		//
+		// 指定された時刻の"YYYY-MM-DDThh:mm:ss"形式の文字列を返します。
+		// 秒、分、日が変わった部分だけを書き換えます。
+		//
+		inline static const Cache& get_cache(std::chrono::sys_seconds seconds)
+		{
+			thread_local auto cache = Cache {};
+
+			// 秒が変わっていない場合はそのまま返します。
+			if (seconds == cache.seconds) return cache;
+
+			auto minutes = std::chrono::floor<std::chrono::minutes>(seconds);
+
+			// 分が変わった場合は
+			if (minutes != cache.minutes)
+			{
+				auto days = std::chrono::floor<std::chrono::days>(minutes);
+
+				// 日が変わった場合は日付を作成し直します。
+				if (days != cache.days)
+				{
+					using utils = Utils<S>;
+
+					auto ymd = std::chrono::year_month_day(days);
+					cache.text = sprintf_S(utils::fmt_date, (int)ymd.year(), (unsigned int)ymd.month(), (unsigned int)ymd.day());
+					cache.date_length = cache.text.length();
+					append_ascii(cache.text, "T00:00:00");
+					cache.days = days;
+				}
+
+				// 時分を書き換えます。
+				auto minute_of_day = (unsigned int)(minutes - days).count();
+				write_2digits(cache.text.data() + cache.date_length + 1, minute_of_day / 60);
+				write_2digits(cache.text.data() + cache.date_length + 4, minute_of_day % 60);
+				cache.minutes = minutes;
+			}
+
+			// 秒を書き換えます。
+			write_2digits(cache.text.data() + cache.date_length + 7, (unsigned int)(seconds - minutes).count());
+			cache.seconds = seconds;
+
+			return cache;
+		}
+
+		//
+		// 時刻を指定された種類で文字列化して追加します。
+		// is_utcがtrueの場合はISO 8601形式の末尾に'Z'を付けます。
+		//
+		template <typename Duration>
+		inline static void append(S& out, Spec spec, const std::chrono::sys_time<Duration>& value, bool is_utc)
+		{
+			if (spec.precision < 0) spec.precision = get_default_precision<typename Duration::period>();
+
+			auto seconds = std::chrono::floor<std::chrono::seconds>(value);
+			const auto& cache = get_cache(seconds);
+
+			switch (spec.kind)
+			{
+			case Kind::date:
+				{
+					out.append(cache.text, 0, cache.date_length);
+
+					return;
+				}
+			case Kind::time:
+				{
+					out.append(cache.text, cache.date_length + 1);
+					append_fraction(out, std::chrono::duration_cast<std::chrono::nanoseconds>(value - seconds), spec.precision);
+
+					return;
+				}
+			}
+
+			out.append(cache.text);
+			append_fraction(out, std::chrono::duration_cast<std::chrono::nanoseconds>(value - seconds), spec.precision);
+			if (is_utc) out += char_type('Z');
+		}
+
+		//
+		// 時刻をサブフォーマットに従って文字列化して追加します。
+		// サブフォーマットが指定されていない場合はISO 8601形式になります。
+		// それ以外のサブフォーマットはエポックからの経過時間の数値の書式化に使用されます。
+		//
+		template <typename Duration>
+		inline static void append(S& out, const S& fmt, const std::chrono::sys_time<Duration>& value, bool is_utc, auto... args)
+		{
+			// 時刻用のサブフォーマットが指定されている場合は
+			if (auto spec = parse(fmt); spec.kind != Kind::none)
+			{
+				append(out, spec, value, is_utc);
+			}
+			// エスケープ用のサブフォーマットが指定されている場合は
+			else if (Escaper<S>::to_kind(fmt) != Escaper<S>::Kind::none)
+			{
+				// ISO 8601形式はエスケープの必要がないので
+				// デフォルトの書式で文字列化します。
+				append(out, Spec { Kind::iso, -1 }, value, is_utc);
+			}
+			// 表示幅用のサブフォーマットが指定されている場合は
+			else if (auto align_spec = typename Aligner<S>::Spec {}; Aligner<S>::parse(fmt, align_spec))
+			{
+				// デフォルトの書式で文字列化してから表示幅を揃えます。
+				auto pos = out.length();
+				append(out, Spec { Kind::iso, -1 }, value, is_utc);
+				Aligner<S>::align(out, pos, align_spec);
+			}
+			// それ以外のサブフォーマットの場合は
+			// 経過時間と同様に数値の書式化に使用します。
+			else
+			{
+				fmt_value_append_S<S, typename Duration::rep>(out, fmt, value.time_since_epoch().count(), args...);
+			}
+		}
+
+		//
+		// 経過時間の単位を追加します。
+		//
+		template <typename Period>
+		inline static void append_unit(S& out)
+		{
+			if constexpr (std::is_same_v<Period, std::nano>) append_ascii(out, "ns");
+			else if constexpr (std::is_same_v<Period, std::micro>) append_ascii(out, "us");
+			else if constexpr (std::is_same_v<Period, std::milli>) append_ascii(out, "ms");
+			else if constexpr (std::is_same_v<Period, std::ratio<1>>) append_ascii(out, "s");
+			else if constexpr (std::is_same_v<Period, std::ratio<60>>) append_ascii(out, "min");
+			else if constexpr (std::is_same_v<Period, std::ratio<3600>>) append_ascii(out, "h");
+			else if constexpr (std::is_same_v<Period, std::ratio<86400>>) append_ascii(out, "d");
+			else
+			{
+				// それ以外の単位は"[num/den]s"の形式にします。
+				out += char_type('[');
+				append_number(out, Period::num);
+				if constexpr (Period::den != 1)
+				{
+					out += char_type('/');
+					append_number(out, Period::den);
+				}
+				append_ascii(out, "]s");
+			}
+		}
+
+		//
+		// 経過時間を単位付きの数値で文字列化して追加します。
+		//
+		template <typename Rep, typename Period>
+		inline static void append_with_unit(S& out, const std::chrono::duration<Rep, Period>& value)
+		{
+			fmt_value_append_S<S, Rep>(out, S {}, value.count());
+			append_unit<Period>(out);
+		}
+
+		//
+		// 経過時間を文字列化して追加します。
+		// サブフォーマットが指定されていない場合は単位付きの数値になります。
+		// "time"の場合は"hh:mm:ss"形式になります。
+		// "iso"、"date"は時刻用なので単位付きの数値になります。
+		// エスケープと表示幅のサブフォーマットは単位付きの数値に適用されます。
+		// それ以外のサブフォーマットは数値の書式化に使用されます。
+		//
+		template <typename Rep, typename Period>
+		inline static void append(S& out, const S& fmt, const std::chrono::duration<Rep, Period>& value, auto... args)
+		{
+			if (fmt.empty())
+			{
+				append_with_unit(out, value);
+
+				return;
+			}
+
+			auto spec = parse(fmt);
+			if (spec.kind != Kind::time)
+			{
+				// 時刻用とエスケープ用のサブフォーマットの場合は
+				// 数値の書式化に使用せずに単位付きの数値にします。
+				if (spec.kind != Kind::none || Escaper<S>::to_kind(fmt) != Escaper<S>::Kind::none)
+				{
+					append_with_unit(out, value);
+				}
+				// 表示幅用のサブフォーマットの場合は
+				// 単位付きの数値にしてから表示幅を揃えます。
+				else if (auto align_spec = typename Aligner<S>::Spec {}; Aligner<S>::parse(fmt, align_spec))
+				{
+					auto pos = out.length();
+					append_with_unit(out, value);
+					Aligner<S>::align(out, pos, align_spec);
+				}
+				else
+				{
+					fmt_value_append_S<S, Rep>(out, fmt, value.count(), args...);
+				}
+
+				return;
+			}
+
+			if (spec.precision < 0) spec.precision = get_default_precision<Period>();
+
+			// 負数の場合は符号を付けて絶対値を書式化します。
+			auto abs_value = value;
+			if (value < value.zero())
+			{
+				out += char_type('-');
+				abs_value = -value;
+			}
+
+			auto seconds = std::chrono::floor<std::chrono::seconds>(abs_value);
+			auto total = (unsigned long long)seconds.count();
+
+			// 時間は2桁以上、分と秒は2桁で追加します。
+			append_number(out, total / 3600, 2);
+			out += char_type(':');
+			append_number(out, total / 60 % 60, 2);
+			out += char_type(':');
+			append_number(out, total % 60, 2);
+			append_fraction(out, std::chrono::duration_cast<std::chrono::nanoseconds>(abs_value - seconds), spec.precision);
+		}
+	};
+
+	//
+	// 時刻をstd::stringに変換して追加します。
+	//
+	template <typename Duration>
+	void fmt_value_append(std::string& out, const std::string& fmt, const std::chrono::sys_time<Duration>& value, auto... args)
+	{
+		TimeEncoder<std::string>::append(out, fmt, value, true, args...);
+	}
+
+	//
+	// ローカル時刻をstd::stringに変換して追加します。
+	// ISO 8601形式の末尾には'Z'を付けません。
+	//
+	template <typename Duration>
+	void fmt_value_append(std::string& out, const std::string& fmt, const std::chrono::local_time<Duration>& value, auto... args)
+	{
+		TimeEncoder<std::string>::append(out, fmt, std::chrono::sys_time<Duration>(value.time_since_epoch()), false, args...);
+	}
+
+	//
+	// 時刻をstd::wstringに変換して追加します。
+	//
+	template <typename Duration>
+	void fmt_value_append(std::wstring& out, const std::wstring& fmt, const std::chrono::sys_time<Duration>& value, auto... args)
+	{
+		TimeEncoder<std::wstring>::append(out, fmt, value, true, args...);
+	}
+
+	//
+	// ローカル時刻をstd::wstringに変換して追加します。
+	// ISO 8601形式の末尾には'Z'を付けません。
+	//
+	template <typename Duration>
+	void fmt_value_append(std::wstring& out, const std::wstring& fmt, const std::chrono::local_time<Duration>& value, auto... args)
+	{
+		TimeEncoder<std::wstring>::append(out, fmt, std::chrono::sys_time<Duration>(value.time_since_epoch()), false, args...);
+	}
+
+	//
+	// 経過時間をstd::stringに変換して追加します。
+	//
+	template <typename Rep, typename Period>
+	void fmt_value_append(std::string& out, const std::string& fmt, const std::chrono::duration<Rep, Period>& value, auto... args)
+	{
+		TimeEncoder<std::string>::append(out, fmt, value, args...);
+	}
+
+	//
+	// 経過時間をstd::wstringに変換して追加します。
+	//
+	template <typename Rep, typename Period>
+	void fmt_value_append(std::wstring& out, const std::wstring& fmt, const std::chrono::duration<Rep, Period>& value, auto... args)
+	{
+		TimeEncoder<std::wstring>::append(out, fmt, value, args...);
+	}
+#endif
+	//
+	// 指定された値を文字列化して追加します。
+	// fmt_value_append()が見つかる場合はそれを使用し、
+	// 見つからない場合は組み込みの型として文字列化します。
+	//
+	template <typename S, typename T>
+	constexpr void fmt_value_append_or_builtin_S(S& out, const S& fmt, const T& value, auto... args)
+	{
+		if constexpr (requires { fmt_value_append(out, fmt, value, args...); })
+			fmt_value_append(out, fmt, value, args...);
+		else
+			fmt_value_append_S<S, T>(out, fmt, value, args...);
+	}
+
+	//
+	// 指定された値を文字列化して追加します。
+	// fmt_value_append()が見つからない場合は
+	// fmt_value_to_string()の戻り値を追加します。
+	//
+	template <typename S, typename T>
+	constexpr void fmt_value_append_or_to_string(S& out, const S& fmt, const T& value, auto&&... args)
+	{
+		if constexpr (requires { fmt_value_append(out, fmt, value, args...); })
+			fmt_value_append(out, fmt, value, args...);
+		else
+			out += fmt_value_to_string(fmt, value, args...);
+	}
+
+	//
+	// この構造体はヘルパーです。
+	//
+	template <typename S> struct Helper;
+
+	//
+	// この構造体はstd::string型に特殊化されたヘルパーです。
+	//
+	template <> struct Helper<std::string>
+	{
+		//
+		// フォーマット用のキーワードです。
+		//
+		inline static constexpr struct {
+			inline static const std::string begin = "{/";
+			inline static const std::string end = "}";
+			inline static const std::string escape = "/";
+			inline static const std::string separator = "$";
+			inline static const std::string invalid_arg_index = "invalid_arg_index";
+		} keyword;
+
+		//
+		// 指定された文字列の出現位置を返します。
+		//
+		inline static const std::string::value_type* find_str(
+			const std::string::value_type* str_begin,
+			const std::string::value_type* str_end,
+			const std::string& pattern)
+		{
+			// 文字列が無効の場合は失敗します。
+			if (str_begin >= str_end) return nullptr;
+
+			// パターンが無効の場合は失敗します。
+			if (pattern.empty()) return nullptr;
+
+			// 文字列の長さを取得します。
+			auto str_length = (size_t)(str_end - str_begin);
+
+			// 文字列がパターンより短い場合はnullptrを返します。
+			if (str_length < pattern.length()) return nullptr;
+
+			// mbrlen()が使用する変数です。
+			auto mb_state = mbstate_t {};
+
+			// 文字列の長さからパターンの長さを除いた数だけループします。
+			for (auto p = str_begin; p <= str_end - pattern.length();)
+			{
+				// 文字の長さを取得します。
+				auto char_length = (int)mbrlen(p, MB_CUR_MAX, &mb_state);
+
+				// 文字の長さが取得できなかった場合はループを終了します。
+				if (char_length < 1) break;
+
+				// 文字列内の現在位置がパターンと一致した場合は
+				if (strncmp(p, pattern.c_str(), pattern.length()) == 0)
+					return p; // 一致した位置を返します。
+
+				// 文字の長さの分だけ現在位置を進めます。
+				p += char_length;
+			}
+
+			// パターンが見つからなかったのでnullptrを返します。
+			return nullptr;
+		}
+
+		//
+		// 指定された文字列を整数に変換して返します。
+		//
+		inline static int to_int(const std::string& s)
+		{
+			try { return std::stoi(s); } catch (...) { return 0; }
+		}
+	};
+
+	//
+	// この構造体はstd::wstring型に特殊化されたヘルパーです。
+	//
+	template <> struct Helper<std::wstring>
+	{
+		//
+		// フォーマット用のキーワードです。
+		//
+		inline static constexpr struct {
+			inline static const std::wstring begin = L"{/";
+			inline static const std::wstring end = L"}";
+			inline static const std::wstring escape = L"/";
+			inline static const std::wstring separator = L"$";
+			inline static const std::wstring invalid_arg_index = L"invalid_arg_index";
+		} keyword;
+
+		//
+		// 指定された文字列の出現位置を返します。
+		//
+		inline static const std::wstring::value_type* find_str(
+			const std::wstring::value_type* str_begin,
+			const std::wstring::value_type* str_end,
+			const std::wstring& pattern)
+		{
+			// 文字列が無効の場合は失敗します。
+			if (str_begin >= str_end) return nullptr;
+
+			// パターンが無効の場合は失敗します。
+			if (pattern.empty()) return nullptr;
+
+			// 文字列の長さを取得します。
+			auto str_length = (size_t)(str_end - str_begin);
+
+			// 文字列がパターンより短い場合はnullptrを返します。
+			if (str_length < pattern.length()) return nullptr;
+
+			// 文字列の長さからパターンの長さを除いた数だけループします。
+			for (auto p = str_begin; p <= str_end - pattern.length(); p++)
+			{
+				// 文字列内の現在位置がパターンと一致した場合は
+				if (wcsncmp(p, pattern.c_str(), pattern.length()) == 0)
+					return p; // 一致した位置を返します。
+			}
+
+			// パターンが見つからなかったのでnullptrを返します。
+			return nullptr;
+		}
+
+		//
+		// 指定された文字列を整数に変換して返します。
+		//
+		inline static int to_int(const std::wstring& s)
+		{
+			try { return std::stoi(s); } catch (...) { return 0; }
+		}
+	};
+
+	//
+	// この構造体は複数の関数オブジェクトをひとつにまとめます。
+	//
+	template <typename... Ts>
+	struct Overloaded : Ts... { using Ts::operator()...; };
+
+	//
+	// この構造体はサブフォーマッタ生成関数オブジェクトです。
+	// サブフォーマッタは文字列化した結果を返すか、出力先に直接追加します。
+	//
+	template <typename S>
+	struct MakeSubFormatter {
+		template <typename T, typename... Args>
+		constexpr auto operator()(const T& value, Args&&... args) const {
+			return Overloaded {
+				[&](const S& fmt) {
+					auto result = S {};
+					fmt_value_append_or_to_string(result, fmt, value, args...);
+					return result;
+				},
+				[&](S& out, const S& fmt) {
+					fmt_value_append_or_to_string(out, fmt, value, args...);
+				},
+			};
+		}
+	};
+
+	//
+	// この値はサブフォーマットが解決されていないことを表します。
+	//
+	inline constexpr size_t c_unresolved_sub_fmt_id = (size_t)-1;
+
+	//
+	// ASCII文字列をS型の文字列に変換して返します。
+	// 名前付きサブフォーマットでstd::stringとstd::wstringの両方に対応するために使用します。
+	//
+	template <typename S>
+	_NODISCARD inline auto from_ascii(const char* s) -> S
+	{
+		auto result = S {};
+		for (; *s; s++) result += (typename S::value_type)*s;
+		return result;
+	}
+
+	//
+	// この構造体は名前付きサブフォーマットのレジストリです。
+	// Handlersはそれぞれ名前(name)と文字列化処理(operator())を持つ型です。
+	// 文字列化処理はstd::stringとstd::wstringの両方で共通です。
+	// 名前は完全ハッシュで解決されるので、名前の数に関係なく一定時間で検索できます。
+	//
+	template <typename... Handlers>
+	struct NamedSubFormats
+	{
+		static_assert(sizeof...(Handlers) != 0, "名前付きサブフォーマットがありません");
+
+		//
+		// 名前付きサブフォーマットの数です。
+		//
+		inline static constexpr size_t c_count = sizeof...(Handlers);
+
+		//
+		// 名前付きサブフォーマットの名前です。
+		//
+		inline static constexpr const char* c_names[] = { Handlers::name... };
+
+		//
+		// ハッシュテーブルのサイズです。
+		// 完全ハッシュが見つかりやすいように名前の数の4倍以上の2のべき乗にします。
+		//
+		inline static constexpr size_t c_table_size = [] {
+			auto size = size_t { 1 };
+			while (size < c_count * 4) size <<= 1;
+			return size;
+		}();
+
+		//
+		// 文字列のハッシュ値を返します。
+		//
+		template <typename C>
+		inline static constexpr uint32_t hash(const C* s, size_t length, uint32_t seed)
+		{
+			auto h = (uint32_t)(2166136261u ^ (seed * 0x9E3779B9u));
+			for (size_t i = 0; i < length; i++)
+				h = (h ^ (uint32_t)s[i]) * 16777619u;
+			return h ^ (h >> 15);
+		}
+
+		//
+		// 文字列の長さを返します。
+		//
+		inline static constexpr size_t length(const char* s)
+		{
+			auto p = s;
+			while (*p) p++;
+			return (size_t)(p - s);
+		}
+
+		//
+		// この構造体は完全ハッシュテーブルです。
+		//
+		struct Table {
+			uint32_t seed;
+			size_t slots[c_table_size];
+		};
+
+		//
+		// 名前が衝突しないシードを探して完全ハッシュテーブルを作成します。
+		// コンパイル時に実行されます。
+		//
+		inline static constexpr auto make_table() -> Table
+		{
+			// 名前が重複している場合はコンパイルエラーにします。
+			for (size_t i = 0; i < c_count; i++)
+				for (size_t j = i + 1; j < c_count; j++)
+					if (std::string_view(c_names[i]) == std::string_view(c_names[j]))
+						throw "名前付きサブフォーマットの名前が重複しています";
+
+			for (auto seed = uint32_t {}; seed < 1000000; seed++)
+			{
+				auto table = Table { seed, {} };
+				for (auto& slot : table.slots) slot = c_unresolved_sub_fmt_id;
+
+				auto is_perfect = true;
+				for (size_t i = 0; i < c_count && is_perfect; i++)
+				{
+					auto& slot = table.slots[hash(c_names[i], length(c_names[i]), seed) & (c_table_size - 1)];
+					if (slot != c_unresolved_sub_fmt_id) is_perfect = false;
+					slot = i;
+				}
+
+				if (is_perfect) return table;
+			}
+
+			throw "完全ハッシュが見つかりませんでした";
+		}
+
+		//
+		// 完全ハッシュテーブルです。
+		//
+		inline static constexpr Table c_table = make_table();
+
+		//
+		// サブフォーマットの名前を解決してインデックスを返します。
+		// 見つからなかった場合はc_unresolved_sub_fmt_idを返します。
+		//
+		template <typename S>
+		inline static constexpr size_t find(const S& fmt)
+		{
+			auto index = c_table.slots[hash(fmt.data(), fmt.length(), c_table.seed) & (c_table_size - 1)];
+			if (index == c_unresolved_sub_fmt_id) return index;
+
+			// ハッシュ値が一致しても名前が一致するとは限らないので比較します。
+			auto name = c_names[index];
+			for (size_t i = 0; i < fmt.length(); i++)
+				if (!name[i] || (typename S::value_type)name[i] != fmt[i]) return c_unresolved_sub_fmt_id;
+			if (name[fmt.length()]) return c_unresolved_sub_fmt_id;
+
+			return index;
+		}
+
+		//
+		// 指定された名前付きサブフォーマットで文字列化します。
+		// 値に対応していない場合はfalseを返します。
+		//
+		template <typename H, typename S, typename T, typename... Args>
+		inline static bool invoke(S& out, const T& value, const Args&... args)
+		{
+			if constexpr (requires { H()(out, value, args...); })
+				return H()(out, value, args...), true;
+			else
+				return false;
+		}
+
+		//
+		// インデックスで指定された名前付きサブフォーマットで文字列化します。
+		// 処理できなかった場合はfalseを返します。
+		//
+		template <typename S, typename T, typename... Args>
+		inline static bool apply(size_t index, S& out, const T& value, const Args&... args)
+		{
+			// 名前付きサブフォーマット毎の文字列化関数のテーブルです。
+			static constexpr bool (*c_invokers[])(S&, const T&, const Args&...) = {
+				&invoke<Handlers, S, T, Args...>...
+			};
+
+			return index < c_count && c_invokers[index](out, value, args...);
+		}
+	};
+
+	//
+	// この構造体は名前付きサブフォーマットに対応したサブフォーマッタ生成関数オブジェクトです。
+	// 名前付きサブフォーマット以外はMakeSubFormatterと同様に処理します。
+	//
+	template <typename S, typename R>
+	struct MakeNamedSubFormatter {
+		//
+		// サブフォーマットを事前に解決します。
+		// プリコンパイル時に呼び出されます。
+		//
+		inline static size_t resolve(const S& fmt)
+		{
+			return R::find(fmt);
+		}
+
+		template <typename T, typename... Args>
+		constexpr auto operator()(const T& value, Args&&... args) const {
+			return Overloaded {
+				[&](const S& fmt) {
+					auto result = S {};
+					append(result, fmt, c_unresolved_sub_fmt_id, value, args...);
+					return result;
+				},
+				[&](S& out, const S& fmt) {
+					append(out, fmt, c_unresolved_sub_fmt_id, value, args...);
+				},
+				[&](S& out, const S& fmt, size_t sub_fmt_id) {
+					append(out, fmt, sub_fmt_id, value, args...);
+				},
+			};
+		}
+
+		//
+		// 値を文字列化して追加します。
+		//
+		template <typename T, typename... Args>
+		inline static void append(S& out, const S& fmt, size_t sub_fmt_id, const T& value, const Args&... args)
+		{
+			// サブフォーマットが解決されていない場合はここで解決します。
+			if (sub_fmt_id == c_unresolved_sub_fmt_id && fmt.length())
+				sub_fmt_id = R::find(fmt);
+
+			// 名前付きサブフォーマットで処理できなかった場合は
+			// デフォルトの処理を実行します。
+			if (!R::apply(sub_fmt_id, out, value, args...))
+				fmt_value_append_or_to_string(out, fmt, value, args...);
+		}
+	};
+
+	//
+	// この構造体はフォーマッタです。
+	//
+	template <typename S, typename M>
+	struct Formatter
+	{
+		//
+		// フォーマット用のヘルパーです。
+		//
+		inline static const Helper<S> utils;
+
+		//
+		// 新規作成したサブフォーマッタを使用して文字列化を実行します。
+		//
+		template <typename T>
+		inline static constexpr auto use_sub_formatter(const T& value, const S& fmt)
+		requires (!std::is_invocable_v<const T&, const S&>) // 引数がサブフォーマッタ(ラムダ)ではない場合は
+		{
+			return use_sub_formatter(M()(value), fmt);
+		}
+
+		//
+		// 既存のサブフォーマッタを使用して文字列化を実行します。
+		//
+		template <typename T>
+		inline static constexpr auto use_sub_formatter(T&& sub_formatter, const S& fmt)
+		requires requires { std::forward<T>(sub_formatter)(fmt); } // 引数がサブフォーマッタ(ラムダ)の場合は
+		{
+			return sub_formatter(fmt);
+		}
+
+		//
+		// 新規作成したサブフォーマッタを使用して文字列化した結果を追加します。
+		//
+		template <typename T>
+		inline static constexpr void use_sub_formatter(S& out, const T& value, const S& fmt, size_t sub_fmt_id)
+		requires (!std::is_invocable_v<const T&, const S&>) // 引数がサブフォーマッタ(ラムダ)ではない場合は
+		{
+			use_sub_formatter(out, M()(value), fmt, sub_fmt_id);
+		}
+
+		//
+		// 既存のサブフォーマッタを使用して文字列化した結果を追加します。
+		//
+		template <typename T>
+		inline static constexpr void use_sub_formatter(S& out, T&& sub_formatter, const S& fmt, size_t sub_fmt_id)
+		requires requires { std::forward<T>(sub_formatter)(fmt); } // 引数がサブフォーマッタ(ラムダ)の場合は
+		{
+			// サブフォーマッタが解決済みのサブフォーマットに対応している場合は
+			if constexpr (requires { sub_formatter(out, fmt, sub_fmt_id); })
+			{
+				// 解決済みのサブフォーマットを渡して出力先に直接追加します。
+				sub_formatter(out, fmt, sub_fmt_id);
+			}
+			// サブフォーマッタが追加に対応している場合は
+			else if constexpr (requires { sub_formatter(out, fmt); })
+			{
+				// 出力先に直接追加します。
+				sub_formatter(out, fmt);
+			}
+			// サブフォーマッタが追加に対応していない場合は
+			else
+			{
+				// 文字列化した結果を追加します。
+				out += sub_formatter(fmt);
+			}
+		}
+
+		//
+		// インデックスで指定された引数が存在しなかった場合に呼び出されます。
+		//
+		inline static constexpr void sub_format_to(S& out, size_t index, const S& sub_fmt, size_t sub_fmt_id)
+		{
+			out += utils.keyword.invalid_arg_index;
+		}
+
+		//
+		// インデックスで指定された引数をサブフォーマット化して追加します。
+		// sub_fmt_idはサブフォーマッタ生成関数オブジェクトが事前に解決したサブフォーマットです。
+		//
+		template <typename Head, typename... Tail>
+		inline static constexpr void sub_format_to(S& out, size_t index, const S& sub_fmt, size_t sub_fmt_id, Head&& head, Tail&&... tail)
+		{
+			// インデックスが無効の場合は
+			if (index < 1)
+			{
+				// 引数が存在しなかった場合の処理を実行します。
+				sub_format_to(out, index, sub_fmt, sub_fmt_id);
+			}
+			// インデックスが一致する場合は
+			else if (index == 1)
+			{
+				// 引数をサブフォーマッタを使用して文字列化して追加します。
+				use_sub_formatter(out, std::forward<Head>(head), sub_fmt, sub_fmt_id);
+			}
+			// インデックスが一致しない場合は
+			else
+			{
+				// インデックスをデクリメントし、次の引数を処理します。
+				sub_format_to(out, --index, sub_fmt, sub_fmt_id, std::forward<Tail>(tail)...);
+			}
+		}
+
+		//
+		// インデックスで指定された引数をサブフォーマット化した文字列を返します。
+		//
+		template <typename... Args>
+		inline static constexpr auto sub_format(size_t index, const S& sub_fmt, Args&&... args) -> S
+		{
+			auto result = S {};
+			sub_format_to(result, index, sub_fmt, c_unresolved_sub_fmt_id, std::forward<Args>(args)...);
+			return result;
+		}
+
+		//
+		// この構造体はパターンを検索してその位置を保持します。
+		//
+		struct Finder {
+			const S::value_type* head;
+			const S::value_type* tail;
+			Finder(const S::value_type* begin, const S::value_type* end, const S& pattern)
+				: head(utils.find_str(begin, end, pattern))
+				, tail(head ? head + pattern.length() : nullptr) {}
+		};
+
+		//
+		// この構造体はフォーマットを先頭から順番にトークンに分割します。
+		//
+		struct Tokenizer
+		{
+			//
+			// この構造体はトークンです。
+			//
+			struct Token {
+				// プレースホルダの場合はtrueになります。
+				bool is_placeholder;
+
+				// リテラルの開始位置と終了位置です。
+				// フォーマット内を直接指しています。
+				const S::value_type* literal_begin;
+				const S::value_type* literal_end;
+
+				// プレースホルダの引数インデックスです。
+				size_t arg_index;
+
+				// プレースホルダのサブフォーマットです。
+				S sub_fmt;
+
+				// サブフォーマットの開始位置と終了位置です。
+				// フォーマット内を直接指しています。
+				const S::value_type* sub_fmt_begin;
+				const S::value_type* sub_fmt_end;
+			};
+
+			// 現在の検索対象位置です。
+			const S::value_type* current_pos;
+
+			// フォーマットの終了位置です。
+			const S::value_type* fmt_end;
+
+			// 現在の使用対象の引数のインデックスです。
+			size_t current_arg_index = 1;
+
+			//
+			// コンストラクタです。
+			//
+			Tokenizer(const S::value_type* fmt_begin, const S::value_type* fmt_end)
+				: current_pos(fmt_begin)
+				, fmt_end(fmt_end)
+			{
+			}
+
+			//
+			// リテラルのトークンを作成します。
+			//
+			inline bool set_literal(Token& token, const S::value_type* begin, const S::value_type* end)
+			{
+				token.is_placeholder = false;
+				token.literal_begin = begin;
+				token.literal_end = end;
+
+				return true;
+			}
+
+			//
+			// 次のトークンを取得します。
+			// トークンが存在しない場合はfalseを返します。
+			//
+			bool next(Token& token)
+			{
+				// 終了位置に到達している場合は失敗します。
+				if (current_pos >= fmt_end) return false;
+
+				// 現在の検索対象位置です。
+				auto pos = current_pos;
+
+				// 開始位置を取得します。
+				auto begin = Finder { pos, fmt_end, utils.keyword.begin };
+
+				// 開始位置が取得できなかった場合は
+				// 最後までをリテラルにします。
+				if (!begin.head)
+					return current_pos = fmt_end, set_literal(token, pos, fmt_end);
+
+				// 開始位置末尾が不正の場合は
+				// 最後までをリテラルにします。
+				if (begin.tail >= fmt_end)
+					return current_pos = fmt_end, set_literal(token, pos, fmt_end);
+
+				// "{/...}"
+				// エスケープされていない場合は
+				if (begin.tail[0] != utils.keyword.escape[0])
+				{
+					// 終了位置を取得します。
+					// 開始位置の末尾から検索します。
+					auto end = Finder { begin.tail, fmt_end, utils.keyword.end };
+
+					// 終了位置が取得できなかった場合は
+					// 最後までをリテラルにします。
+					if (!end.head)
+						return current_pos = fmt_end, set_literal(token, pos, fmt_end);
+
+					// 開始位置より前にリテラルが存在する場合は
+					// 先にリテラルを返します。
+					if (begin.head != pos)
+						return current_pos = begin.head, set_literal(token, pos, begin.head);
+
+					// 文字列化に使用する引数のインデックスです。
+					token.arg_index = current_arg_index;
+
+					// セパレータの位置を取得します。
+					auto separator = Finder { begin.tail, end.head, utils.keyword.separator };
+
+					// "{/arg_index$sub_fmt}"
+					// セパレータが存在する場合は
+					if (separator.head)
+					{
+						// 前半文字列から引数インデックスを取得します。
+						token.arg_index = utils.to_int({ begin.tail, separator.head });
+
+						// 後半文字列からサブフォーマットを取得します。
+						token.sub_fmt_begin = separator.tail;
+					}
+					// "{/sub_fmt}"
+					// セパレータが存在しない場合は
+					else
+					{
+						// サブフォーマットを取得します。
+						token.sub_fmt_begin = begin.tail;
+					}
+
+					token.sub_fmt_end = end.head;
+					token.sub_fmt.assign(token.sub_fmt_begin, token.sub_fmt_end);
+					token.is_placeholder = true;
+
+					// 次の引数を使用対象にします。
+					current_arg_index++;
+
+					// 現在の検索対象位置を終了位置末尾に変更します。
+					current_pos = end.tail;
+
+					return true;
+				}
+				// "{//..."
+				// エスケープされている場合は
+				else
+				{
+					// 開始位置より前にリテラルが存在する場合は
+					// 先にリテラルを返します。
+					if (begin.head != pos)
+						return current_pos = begin.head, set_literal(token, pos, begin.head);
+
+					// 現在の検索対象位置を開始位置末尾に変更します。
+					current_pos = begin.tail + 1;
+
+					// "{/"をリテラルにします。
+					return set_literal(token, begin.head, begin.tail);
+				}
+			}
+		};
+
+		//
+		// フォーマット化された文字列を返します。
+		//
+		template <typename... Args>
+		inline static constexpr auto format(const S& fmt, Args&&... args) -> S
+		{
+			//
+			// この構造体は文字列化したプレースホルダの結果内の位置を記憶します。
+			// 同じ引数とサブフォーマットのプレースホルダは結果をコピーして再利用します。
+			//
+			struct Memo {
+				size_t arg_index;
+				const S::value_type* sub_fmt_begin;
+				size_t sub_fmt_length;
+				size_t pos;
+				size_t length;
+			};
+
+			// 記憶できるプレースホルダの最大数です。
+			constexpr size_t c_max_memo_count = 16;
+
+			// 最終的に返す結果を格納する変数です。
+			auto result = S {};
+
+			// フォーマットをトークンに分割します。
+			auto tokenizer = Tokenizer { fmt.c_str(), fmt.c_str() + fmt.length() };
+
+			// 取得したトークンを格納する変数です。
+			auto token = typename Tokenizer::Token {};
+
+			// 文字列化したプレースホルダの記憶です。
+			Memo memos[c_max_memo_count];
+			size_t memo_count = 0;
+
+			while (tokenizer.next(token))
+			{
+				// プレースホルダの場合は
+				if (token.is_placeholder)
+				{
+					auto sub_fmt_length = (size_t)(token.sub_fmt_end - token.sub_fmt_begin);
+
+					// 同じ引数とサブフォーマットのプレースホルダを検索します。
+					auto memo = memos;
+					for (; memo != memos + memo_count; memo++)
+					{
+						if (memo->arg_index == token.arg_index &&
+							memo->sub_fmt_length == sub_fmt_length &&
+							S::traits_type::compare(memo->sub_fmt_begin, token.sub_fmt_begin, sub_fmt_length) == 0)
+						{
+							break;
+						}
+					}
+
+					// 既に文字列化されている場合は
+					if (memo != memos + memo_count)
+					{
+						// 以前の結果をコピーします。
+						result.append(result, memo->pos, memo->length);
+					}
+					// まだ文字列化されていない場合は
+					else
+					{
+						auto pos = result.length();
+
+						// インデックスの位置にある引数を文字列化して結果に追加します。
+						sub_format_to(result, token.arg_index, token.sub_fmt, c_unresolved_sub_fmt_id, args...);
+
+						// 記憶に空きがある場合は結果内の位置を記憶します。
+						if (memo_count < c_max_memo_count)
+						{
+							memos[memo_count++] = {
+								token.arg_index, token.sub_fmt_begin, sub_fmt_length,
+								pos, result.length() - pos,
+							};
+						}
+					}
+				}
+				// リテラルの場合は
+				else
+				{
+					// リテラルを結果に追加します。
+					result.append(token.literal_begin, token.literal_end);
+				}
+			}
+
+			return result;
+		}
+
+#ifdef _VECTOR_
+		//
+		// この構造体はプリコンパイル済みのフォーマットです。
+		// 同じフォーマットを繰り返し使用する場合は字句解析を省略できます。
+		//
+		struct Compiled
+		{
+			//
+			// この値は記憶位置が存在しないことを表します。
+			//
+			inline static constexpr size_t npos = (size_t)-1;
+
+			//
+			// この構造体はプリコンパイル済みのトークンです。
+			//
+			struct Token {
+				// プレースホルダの場合はtrueになります。
+				bool is_placeholder;
+
+				// フォーマット内のリテラルの位置と長さです。
+				size_t literal_pos;
+				size_t literal_length;
+
+				// プレースホルダの引数インデックスです。
+				size_t arg_index;
+
+				// プレースホルダのサブフォーマットです。
+				S sub_fmt;
+
+				// 同じ引数とサブフォーマットのプレースホルダが
+				// 他にも存在する場合の記憶位置のインデックスです。
+				size_t memo_index;
+
+				// サブフォーマッタ生成関数オブジェクトが解決したサブフォーマットです。
+				size_t sub_fmt_id;
+			};
+
+			// フォーマットのコピーです。
+			S fmt;
+
+			// トークンの配列です。
+			std::vector<Token> tokens;
+
+			// リテラルの長さの合計です。
+			size_t literal_length = 0;
+
+			// 記憶位置の数です。
+			size_t memo_count = 0;
+
+			//
+			// コンストラクタです。
+			//
+			explicit Compiled(const S& fmt)
+				: fmt(fmt)
+			{
+				// フォーマットのコピーをトークンに分割します。
+				auto fmt_begin = this->fmt.c_str();
+				auto tokenizer = Tokenizer { fmt_begin, fmt_begin + this->fmt.length() };
+				auto token = typename Tokenizer::Token {};
+
+				while (tokenizer.next(token))
+				{
+					// プレースホルダの場合は
+					if (token.is_placeholder)
+					{
+						// サブフォーマッタ生成関数オブジェクトが対応している場合は
+						// サブフォーマットを事前に解決しておきます。
+						auto sub_fmt_id = c_unresolved_sub_fmt_id;
+						if constexpr (requires { M::resolve(token.sub_fmt); })
+							sub_fmt_id = M::resolve(token.sub_fmt);
+
+						tokens.push_back({ true, 0, 0, token.arg_index, token.sub_fmt, npos, sub_fmt_id });
+					}
+					// リテラルの場合は
+					else
+					{
+						auto literal_pos = (size_t)(token.literal_begin - fmt_begin);
+						auto literal_length = (size_t)(token.literal_end - token.literal_begin);
+
+						tokens.push_back({ false, literal_pos, literal_length, 0, {}, npos, c_unresolved_sub_fmt_id });
+
+						this->literal_length += literal_length;
+					}
+				}
+
+				// 引数インデックス毎に最初に出現したプレースホルダのインデックスです。
+				auto firsts = std::vector<std::vector<size_t>>(tokens.size() + 1);
+
+				for (size_t i = 0; i < tokens.size(); i++)
+				{
+					auto& token = tokens[i];
+
+					// プレースホルダではない場合は何もしません。
+					if (!token.is_placeholder) continue;
+
+					// 引数インデックスが大きすぎる場合は何もしません。
+					if (token.arg_index >= firsts.size()) continue;
+
+					// 同じ引数とサブフォーマットのプレースホルダを検索します。
+					auto& bucket = firsts[token.arg_index];
+					auto found = false;
+					for (auto first_index : bucket)
+					{
+						auto& first = tokens[first_index];
+						if (first.sub_fmt != token.sub_fmt) continue;
+
+						// 両方のプレースホルダに同じ記憶位置を割り当てます。
+						if (first.memo_index == npos) first.memo_index = memo_count++;
+						token.memo_index = first.memo_index;
+						found = true;
+						break;
+					}
+
+					// 見つからなかった場合は最初のプレースホルダとして追加します。
+					if (!found) bucket.push_back(i);
+				}
+			}
+		};
+
+		//
+		// この構造体は文字列化したプレースホルダの結果内の位置です。
+		//
+		struct Memo {
+			size_t pos = Compiled::npos;
+			size_t length = 0;
+		};
+
+		//
+		// プリコンパイル済みのフォーマットの指定された範囲のトークンを
+		// フォーマット化して結果に追加します。
+		//
+		template <typename... Args>
+		inline static constexpr void render_tokens(S& result, const Compiled& compiled,
+			size_t token_begin, size_t token_end, std::vector<Memo>& memos, Args&&... args)
+		{
+			for (auto i = token_begin; i < token_end; i++)
+			{
+				const auto& token = compiled.tokens[i];
+
+				// プレースホルダの場合は
+				if (token.is_placeholder)
+				{
+					// 記憶位置が存在しない場合は
+					if (token.memo_index == Compiled::npos)
+					{
+						// インデックスの位置にある引数を文字列化して結果に追加します。
+						sub_format_to(result, token.arg_index, token.sub_fmt, token.sub_fmt_id, args...);
+					}
+					// 既に文字列化されている場合は
+					else if (auto& memo = memos[token.memo_index]; memo.pos != Compiled::npos)
+					{
+						// 以前の結果をコピーします。
+						result.append(result, memo.pos, memo.length);
+					}
+					// まだ文字列化されていない場合は
+					else
+					{
+						memo.pos = result.length();
+
+						// インデックスの位置にある引数を文字列化して結果に追加します。
+						sub_format_to(result, token.arg_index, token.sub_fmt, token.sub_fmt_id, args...);
+
+						memo.length = result.length() - memo.pos;
+					}
+				}
+				// リテラルの場合は
+				else
+				{
+					// リテラルを結果に追加します。
+					result.append(compiled.fmt, token.literal_pos, token.literal_length);
+				}
+			}
+		}
+
+		//
+		// プリコンパイル済みのフォーマットを使用して
+		// フォーマット化された文字列を返します。
+		// 同じ引数とサブフォーマットのプレースホルダは一度だけ文字列化されます。
+		//
+		template <typename... Args>
+		inline static constexpr auto format(const Compiled& compiled, Args&&... args) -> S
+		{
+			// 最終的に返す結果を格納する変数です。
+			auto result = S {};
+			result.reserve(compiled.literal_length);
+
+			// 文字列化したプレースホルダの記憶です。
+			auto memos = std::vector<Memo>(compiled.memo_count);
+
+			render_tokens(result, compiled, 0, compiled.tokens.size(), memos, args...);
+
+			return result;
+		}
+#ifdef _THREAD_
+		//
+		// 1スレッドあたりの最小のトークン数です。
+		// これより少ない場合はスレッドを減らします。
+		//
+		inline static constexpr size_t c_min_tokens_per_thread = 1024;
+
+		//
+		// プリコンパイル済みのフォーマットを複数のスレッドで
+		// フォーマット化して文字列を返します。
+		// トークンを範囲に分割してスレッド毎のバッファに文字列化してから連結します。
+		// thread_countが0の場合はハードウェアのスレッド数を使用します。
+		// 引数とサブフォーマッタは複数のスレッドから同時に使用されます。
+		//
+		template <typename... Args>
+		inline static auto format_parallel(const Compiled& compiled, size_t thread_count, Args&&... args) -> S
+		{
+			if (!thread_count) thread_count = std::thread::hardware_concurrency();
+
+			// トークンが少ない場合はスレッドを減らします。
+			auto token_count = compiled.tokens.size();
+			if (thread_count > token_count / c_min_tokens_per_thread)
+				thread_count = token_count / c_min_tokens_per_thread;
+
+			// 1スレッドの場合は通常通りフォーマット化します。
+			if (thread_count <= 1) return format(compiled, args...);
+
+			//
+			// この構造体はスレッド毎の作業領域です。
+			//
+			struct Part {
+				size_t token_begin = 0;
+				size_t token_end = 0;
+				S buffer;
+				std::exception_ptr exception;
+			};
+
+			auto parts = std::vector<Part>(thread_count);
+			for (size_t i = 0; i < thread_count; i++)
+			{
+				parts[i].token_begin = token_count * i / thread_count;
+				parts[i].token_end = token_count * (i + 1) / thread_count;
+			}
+
+			// 範囲内のトークンをフォーマット化します。
+			auto render = [&](Part& part)
+			{
+				try
+				{
+					// 範囲内のリテラルの長さを事前に確保しておきます。
+					auto literal_length = size_t {};
+					for (auto i = part.token_begin; i < part.token_end; i++)
+						literal_length += compiled.tokens[i].literal_length;
+					part.buffer.reserve(literal_length);
+
+					// 文字列化したプレースホルダの記憶はスレッド毎に持ちます。
+					auto memos = std::vector<Memo>(compiled.memo_count);
+
+					render_tokens(part.buffer, compiled, part.token_begin, part.token_end, memos, args...);
+				}
+				catch (...)
+				{
+					part.exception = std::current_exception();
+				}
+			};
+
+			// 最初の範囲以外はワーカースレッドでフォーマット化します。
+			auto threads = std::vector<std::thread>();
+			threads.reserve(thread_count - 1);
+			auto started_count = size_t { 1 };
+			try
+			{
+				for (; started_count < thread_count; started_count++)
+					threads.emplace_back([&render, &part = parts[started_count]]() { render(part); });
+			}
+			catch (...)
+			{
+				// スレッドを作成できなかった場合は
+				// 残りの範囲を呼び出し元のスレッドでフォーマット化します。
+			}
+
+			// 最初の範囲とワーカースレッドに渡せなかった範囲は
+			// 呼び出し元のスレッドでフォーマット化します。
+			// render()は例外を送出しないので、作成済みのスレッドは必ず合流されます。
+			render(parts[0]);
+			for (auto i = started_count; i < thread_count; i++)
+				render(parts[i]);
+
+			for (auto& thread : threads)
+				thread.join();
+
+			// いずれかのスレッドで例外が発生した場合は再送出します。
+			for (const auto& part : parts)
+				if (part.exception) std::rethrow_exception(part.exception);
+
+			// 各バッファを連結します。
+			auto length = size_t {};
+			for (const auto& part : parts)
+				length += part.buffer.length();
+
+			auto result = S {};
+			result.reserve(length);
+			for (const auto& part : parts)
+				result += part.buffer;
+
+			return result;
+		}
+#endif
+		//
+		// この構造体は頻繁に更新されるフォーマットの書式化結果を保持します。
+		// 引数を更新すると、その引数を使用しているプレースホルダだけを書式化し直して
+		// 結果を部分的に書き換えます。
+		// 書式化結果はトークンのブロック毎のバッファに分けて保持しているので、
+		// 長さが変わる場合もずらすのはブロック内のトークンの位置だけです。
+		// 連結した書式化結果には、長さが変わったブロックだけをstr()で必要になったときに反映します。
+		//
+		struct Live
+		{
+			//
+			// 1ブロックあたりのトークンの数です。
+			//
+			inline static constexpr size_t c_tokens_per_block = 64;
+
+			// プリコンパイル済みのフォーマットです。
+			Compiled compiled;
+
+			// ブロック毎の書式化結果です。
+			std::vector<S> blocks;
+
+			// トークン毎のブロック内の位置と長さです。
+			std::vector<size_t> offsets;
+			std::vector<size_t> lengths;
+
+			// 引数インデックス毎のプレースホルダのトークンのインデックスです。
+			std::vector<std::vector<size_t>> placeholders;
+
+			// プレースホルダを書式化し直すバッファです。
+			S buffer;
+
+			// 連結した書式化結果です。
+			mutable S result;
+
+			// 連結した書式化結果内のブロックの位置と長さです。
+			mutable std::vector<size_t> block_positions;
+			mutable std::vector<size_t> block_lengths;
+
+			// 連結した書式化結果に反映されていないブロックはtrueになります。
+			mutable std::vector<bool> dirty_blocks;
+
+			// 連結した書式化結果に反映されていない最初のブロックのインデックスです。
+			// すべて反映されている場合はCompiled::nposになります。
+			mutable size_t first_dirty_block = Compiled::npos;
+
+			//
+			// コンストラクタです。
+			// すべての引数を書式化します。
+			//
+			template <typename... Args>
+			explicit Live(const S& fmt, Args&&... args)
+				: compiled(fmt)
+				, blocks((compiled.tokens.size() + c_tokens_per_block - 1) / c_tokens_per_block)
+				, offsets(compiled.tokens.size())
+				, lengths(compiled.tokens.size())
+				, dirty_blocks(blocks.size())
+			{
+				for (size_t i = 0; i < compiled.tokens.size(); i++)
+				{
+					const auto& token = compiled.tokens[i];
+					auto& text = blocks[i / c_tokens_per_block];
+
+					offsets[i] = text.length();
+
+					// プレースホルダの場合は
+					if (token.is_placeholder)
+					{
+						// インデックスの位置にある引数を文字列化してブロックに追加します。
+						sub_format_to(text, token.arg_index, token.sub_fmt, token.sub_fmt_id, args...);
+
+						// 更新できるように引数インデックス毎にトークンを記録しておきます。
+						// 引数の数を超えるインデックスは更新できないので記録しません。
+						if (token.arg_index >= 1 && token.arg_index <= sizeof...(Args))
+						{
+							if (token.arg_index >= placeholders.size())
+								placeholders.resize(token.arg_index + 1);
+
+							placeholders[token.arg_index].push_back(i);
+						}
+					}
+					// リテラルの場合は
+					else
+					{
+						// リテラルをブロックに追加します。
+						text.append(compiled.fmt, token.literal_pos, token.literal_length);
+					}
+
+					lengths[i] = text.length() - offsets[i];
+				}
+
+				join();
+			}
+
+			//
+			// インデックスで指定された引数を更新します。
+			// その引数を使用しているプレースホルダだけを書式化し直します。
+			//
+			template <typename T>
+			void update(size_t index, T&& value)
+			{
+				if (index >= placeholders.size()) return;
+
+				// 直前に書式化したプレースホルダの記憶位置です。
+				auto memo_index = Compiled::npos;
+
+				for (auto i : placeholders[index])
+				{
+					const auto& token = compiled.tokens[i];
+					auto block_index = i / c_tokens_per_block;
+					auto& block = blocks[block_index];
+
+					// 直前と同じ引数とサブフォーマットではない場合は
+					// 新しい値を書式化します。
+					if (token.memo_index == Compiled::npos || token.memo_index != memo_index)
+					{
+						buffer.clear();
+						sub_format_to(buffer, 1, token.sub_fmt, token.sub_fmt_id, value);
+						memo_index = token.memo_index;
+					}
+
+					// 長さが変わらない場合は
+					if (buffer.length() == lengths[i])
+					{
+						// ブロックをその場で上書きします。
+						S::traits_type::copy(block.data() + offsets[i], buffer.data(), buffer.length());
+
+						// ブロックが連結した書式化結果に反映されている場合はそちらも上書きします。
+						if (!dirty_blocks[block_index])
+							S::traits_type::copy(result.data() + block_positions[block_index] + offsets[i], buffer.data(), buffer.length());
+					}
+					// 長さが変わる場合は
+					else
+					{
+						// ブロック内で置き換えて、ブロック内の以降のトークンの位置をずらします。
+						block.replace(offsets[i], lengths[i], buffer);
 
-			// 文字列の長さを取得します。
-			auto str_length = (size_t)(str_end - str_begin);
+						auto delta = buffer.length() - lengths[i];
+						auto block_end = (block_index + 1) * c_tokens_per_block;
+						if (block_end > offsets.size()) block_end = offsets.size();
+						for (auto j = i + 1; j < block_end; j++)
+							offsets[j] += delta;
 
-			// 文字列がパターンより短い場合はnullptrを返します。
-			if (str_length < pattern.length()) return nullptr;
+						lengths[i] = buffer.length();
 
-			// 文字列の長さからパターンの長さを除いた数だけループします。
-			for (auto p = str_begin; p <= str_end - pattern.length(); p++)
-			{
-				// 文字列内の現在位置がパターンと一致した場合は
-				if (wcsncmp(p, pattern.c_str(), pattern.length()) == 0)
-					return p; // 一致した位置を返します。
+						// ブロックは次にstr()が呼ばれたときに連結した書式化結果に反映します。
+						dirty_blocks[block_index] = true;
+						if (block_index < first_dirty_block) first_dirty_block = block_index;
+					}
+				}
 			}
 
-			// パターンが見つからなかったのでnullptrを返します。
-			return nullptr;
-		}
+			//
+			// ブロックを連結して書式化結果を作成し直します。
+			//
+			void join() const
+			{
+				auto length = size_t {};
+				for (const auto& block : blocks)
+					length += block.length();
 
-		//
-		// 指定された文字列を整数に変換して返します。
-		//
-		inline static int to_int(const std::wstring& s)
-		{
-			try { return std::stoi(s); } catch (...) { return 0; }
-		}
-	};
+				result.clear();
+				result.reserve(length);
+				block_positions.resize(blocks.size());
+				block_lengths.resize(blocks.size());
 
-	//
-	// この構造体はサブフォーマッタ生成関数オブジェクトです。
-	//
-	template <typename S>
-	struct MakeSubFormatter {
-		template <typename T, typename... Args>
-		constexpr auto operator()(const T& value, Args&&... args) const {
-			return [&](const S& fmt) {
-				return fmt_value_to_string(fmt, value, args...);
-			};
-		}
-	};
+				for (size_t i = 0; i < blocks.size(); i++)
+				{
+					block_positions[i] = result.length();
+					block_lengths[i] = blocks[i].length();
+					result += blocks[i];
+				}
+			}
 
-	//
-	// この構造体はフォーマッタです。
-	//
-	template <typename S, typename M>
-	struct Formatter
-	{
-		//
-		// フォーマット用のヘルパーです。
-		//
-		inline static const Helper<S> utils;
+			//
+			// 反映されていないブロックを連結した書式化結果に書き込みます。
+			// 最初のブロックより前の部分には触れずに、
+			// 以降の反映済みのブロックはその場で移動します。
+			//
+			void splice() const
+			{
+				// 最初のブロック以降の新しい位置を算出します。
+				auto new_positions = std::vector<size_t>(blocks.size() - first_dirty_block);
+				auto new_length = block_positions[first_dirty_block];
+				for (auto b = first_dirty_block; b < blocks.size(); b++)
+				{
+					new_positions[b - first_dirty_block] = new_length;
+					new_length += dirty_blocks[b] ? blocks[b].length() : block_lengths[b];
+				}
 
-		//
-		// 新規作成したサブフォーマッタを使用して文字列化を実行します。
-		//
-		template <typename T>
-		inline static constexpr auto use_sub_formatter(const T& value, const S& fmt)
-		{
-			return use_sub_formatter(M()(value), fmt);
-		}
+				// 伸びる場合は先に伸ばしておきます。
+				if (new_length > result.length()) result.resize(new_length);
 
-		//
-		// 既存のサブフォーマッタを使用して文字列化を実行します。
-		//
-		template <typename T>
-		inline static constexpr auto use_sub_formatter(T&& sub_formatter, const S& fmt)
-		requires requires { std::forward<T>(sub_formatter)(fmt); } // 引数がサブフォーマッタ(ラムダ)の場合は
-		{
-			return sub_formatter(fmt);
-		}
+				// ブロックを新しい位置に書き込みます。
+				auto place = [&](size_t b)
+				{
+					auto dst = result.data() + new_positions[b - first_dirty_block];
+
+					if (dirty_blocks[b])
+						S::traits_type::copy(dst, blocks[b].data(), blocks[b].length());
+					else if (dst != result.data() + block_positions[b])
+						S::traits_type::move(dst, result.data() + block_positions[b], block_lengths[b]);
+				};
+
+				// 次のブロックが後ろにずれる場合は移動先が次のブロックの移動元に重なるので、
+				// 次のブロックを先に書き込みます。
+				// つまり、後ろにずれるブロックが続く範囲はまとめて後ろから書き込みます。
+				auto run_begin = first_dirty_block;
+				for (auto b = first_dirty_block; b < blocks.size(); b++)
+				{
+					if (b + 1 == blocks.size() || new_positions[b + 1 - first_dirty_block] <= block_positions[b + 1])
+					{
+						for (auto r = b + 1; r-- > run_begin; ) place(r);
+						run_begin = b + 1;
+					}
+				}
 
-		//
-		// インデックスで指定された引数が存在しなかった場合に呼び出されます。
-		//
-		inline static constexpr auto sub_format(size_t index, const S& sub_fmt) -> S
-		{
-			return utils.keyword.invalid_arg_index;
-		}
+				// 縮む場合は最後に縮めます。
+				result.resize(new_length);
 
-		//
-		// インデックスで指定された引数をサブフォーマット化した文字列を返します。
-		//
-		template <typename Head, typename... Tail>
-		inline static constexpr auto sub_format(size_t index, const S& sub_fmt, Head&& head, Tail&&... tail) -> S
-		{
-			// インデックスが無効の場合は
-			if (index < 1)
-			{
-				// 引数が存在しなかった場合の処理を実行します。
-				return sub_format(index, sub_fmt);
+				// 位置と長さを更新して反映済みにします。
+				for (auto b = first_dirty_block; b < blocks.size(); b++)
+				{
+					block_positions[b] = new_positions[b - first_dirty_block];
+					block_lengths[b] = dirty_blocks[b] ? blocks[b].length() : block_lengths[b];
+					dirty_blocks[b] = false;
+				}
+
+				first_dirty_block = Compiled::npos;
 			}
-			// インデックスが一致する場合は
-			else if (index == 1)
+
+			//
+			// 書式化結果を返します。
+			// 長さが変わる更新があった場合は、そのブロックだけを連結した書式化結果に反映します。
+			//
+			const S& str() const
 			{
-				// 引数をサブフォーマッタを使用して文字列化して返します。
-				return use_sub_formatter(std::forward<Head>(head), sub_fmt);
+				if (first_dirty_block != Compiled::npos) splice();
+
+				return result;
 			}
-			// インデックスが一致しない場合は
-			else
+
+			//
+			// 書式化結果をブロック毎に関数に渡します。
+			// 連結せずに出力する場合に使用します。
+			//
+			template <typename F>
+			void for_each_block(F&& f) const
 			{
-				// インデックスをデクリメントし、次の引数を処理します。
-				return sub_format(--index, sub_fmt, std::forward<Tail>(tail)...);
+				for (const auto& block : blocks)
+					f(block);
 			}
-		}
+		};
+#endif
 
 		//
-		// フォーマット化された文字列を返します。
+		// この構造体はformat_chunks()に渡された引数を保持します。
+		// 左辺値の場合は参照を保持し、右辺値の場合は値をムーブして保持します。
 		//
-		template <typename... Args>
-		inline static constexpr auto format(const S& fmt, Args&&... args) -> S
+		template <typename T>
+		struct ChunkArg
+		{
+			T value;
+		};
+
+		//
+		// このクラスはフォーマット化された文字列を断片ごとに返す入力範囲です。
+		// リテラルはフォーマット内を直接指し、
+		// プレースホルダは使い回されるバッファに文字列化されます。
+		//
+		template <typename R>
+		struct Chunks
 		{
 			//
-			// この構造体はパターンを検索してその位置を保持します。
+			// 断片の型です。
 			//
-			struct Finder {
-				const S::value_type* head;
-				const S::value_type* tail;
-				Finder(const S::value_type* begin, const S::value_type* end, const S& pattern)
-					: head(utils.find_str(begin, end, pattern))
-					, tail(head ? head + pattern.length() : nullptr) {}
-			};
-
-			// フォーマットの開始位置です。
-			auto fmt_begin = fmt.c_str();
-
-			// フォーマットの終了位置です。
-			auto fmt_end = fmt.c_str() + fmt.length();
-
-			// 最終的に返す結果を格納する変数です。
-			auto result = S {};
+			using chunk_type = std::basic_string_view<typename S::value_type>;
 
-			// 現在の使用対象の引数のインデックスです。
-			auto current_arg_index = size_t { 1 };
+			//
+			// この構造体は断片を順番に返すイテレータです。
+			//
+			struct iterator
+			{
+				using value_type = chunk_type;
+				using difference_type = ptrdiff_t;
 
-			// 現在の検索対象位置です。
-			auto current_pos = fmt_begin;
+				Chunks* owner = nullptr;
 
-			while (*current_pos)
-			{
-				// 開始位置を取得します。
-				auto begin = Finder { current_pos, fmt_end, utils.keyword.begin };
+				chunk_type operator*() const { return owner->chunk; }
+				iterator& operator++() { if (!owner->advance()) owner = nullptr; return *this; }
+				void operator++(int) { ++*this; }
+				bool operator==(const iterator& rhs) const { return owner == rhs.owner; }
+			};
 
-				// 開始位置が取得できなかった場合はループを終了します。
-				if (!begin.head)
-					break;
+			// 渡されたフォーマットです。
+			// リテラルの断片はこの文字列内を指します。
+			const S fmt;
 
-				// 開始位置末尾が不正の場合はループを終了します。
-				if (begin.tail >= fmt_end)
-					break;
+			// 引数を文字列化する関数オブジェクトです。
+			R render;
 
-				// 現在の検索位置から開始位置までを結果に追加します。
-				result += { current_pos, begin.head };
+			// フォーマットをトークンに分割します。
+			Tokenizer tokenizer { nullptr, nullptr };
 
-				// "{/...}"
-				// エスケープされていない場合は
-				if (begin.tail[0] != utils.keyword.escape[0])
-				{
-					// 終了位置を取得します。
-					// 開始位置の末尾から検索します。
-					auto end = Finder { begin.tail, fmt_end, utils.keyword.end };
+			// 取得したトークンです。
+			typename Tokenizer::Token token {};
 
-					// 終了位置が取得できなかった場合はループを終了します。
-					if (!end.head)
-						break;
+			// プレースホルダを文字列化するバッファです。
+			S buffer;
 
-					// 文字列化に使用する引数のインデックスです。
-					auto arg_index = current_arg_index;
+			// 現在の断片です。
+			chunk_type chunk;
 
-					// 文字列化に使用するサブフォーマットです。
-					auto sub_fmt = S {};
+			//
+			// コンストラクタです。
+			//
+			Chunks(S&& fmt, R&& render)
+				: fmt(std::move(fmt))
+				, render(std::move(render))
+			{
+			}
 
-					// セパレータの位置を取得します。
-					auto separator = Finder { begin.tail, end.head, utils.keyword.separator };
+			//
+			// 断片はフォーマット内と内部のバッファを指すので
+			// コピーと移動を禁止します。
+			//
+			Chunks(const Chunks&) = delete;
+			Chunks& operator=(const Chunks&) = delete;
 
-					// "{/arg_index$sub_fmt}"
-					// セパレータが存在する場合は
-					if (separator.head)
+			//
+			// 次の断片に進みます。
+			// 断片が存在しない場合はfalseを返します。
+			//
+			bool advance()
+			{
+				while (tokenizer.next(token))
+				{
+					// プレースホルダの場合は
+					if (token.is_placeholder)
 					{
-						// 前半文字列から引数インデックスを取得します。
-						arg_index = utils.to_int({ begin.tail, separator.head });
+						// インデックスの位置にある引数をバッファに文字列化します。
+						buffer.clear();
+						render(buffer, token.arg_index, token.sub_fmt);
 
-						// 後半文字列からサブフォーマットを取得します。
-						sub_fmt = { separator.tail, end.head };
+						chunk = buffer;
 					}
-					// "{/sub_fmt}"
-					// セパレータが存在しない場合は
+					// リテラルの場合は
 					else
 					{
-						// サブフォーマットを取得します。
-						sub_fmt = { begin.tail, end.head };
+						// フォーマット内を直接指します。
+						chunk = { token.literal_begin, (size_t)(token.literal_end - token.literal_begin) };
 					}
 
-					// インデックスの位置にある引数を文字列化して結果に追加します。
-					result += sub_format(arg_index, sub_fmt, args...);
+					// 空の断片は返さずに次に進みます。
+					if (chunk.size()) return true;
+				}
 
-					// 次の引数を使用対象にします。
-					current_arg_index++;
+				return false;
+			}
 
-					// 現在の検索対象位置を終了位置末尾に変更します。
-					current_pos = end.tail;
-				}
-				// "{//..."
-				// エスケープされている場合は
-				else
-				{
-					// "{/"を結果に追加します。
-					result += utils.keyword.begin;
+			//
+			// 先頭の断片を指すイテレータを返します。
+			//
+			iterator begin()
+			{
+				tokenizer = { fmt.c_str(), fmt.c_str() + fmt.length() };
 
-					// 現在の検索対象位置を開始位置末尾に変更します。
-					current_pos = begin.tail + 1;
-				}
+				return { advance() ? this : nullptr };
+			}
+
+			//
+			// 終端を指すイテレータを返します。
+			//
+			iterator end()
+			{
+				return {};
 			}
+		};
 
-			// 現在の検索位置から最後までを結果に追加します。
-			result += { current_pos, fmt_end };
+		//
+		// フォーマット化された文字列を断片ごとに返す入力範囲を返します。
+		// フォーマットは入力範囲にムーブして保持されます。
+		// 左辺値の引数は参照して保持されるので、断片を取得し終えるまで有効である必要があります。
+		// 右辺値の引数はムーブして保持されます。
+		//
+		template <typename... Args>
+		inline static constexpr auto format_chunks(S fmt, Args&&... args)
+		{
+			auto render = [...args = ChunkArg<Args> { std::forward<Args>(args) }](S& out, size_t index, const S& sub_fmt) {
+				sub_format_to(out, index, sub_fmt, c_unresolved_sub_fmt_id, args.value...);
+			};
 
-			return result;
+			return Chunks<decltype(render)>(std::move(fmt), std::move(render));
 		}
 	};
 
@@ -662,4 +3205,102 @@ namespace sprintfmt
 	{
 		return sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::format(fmt, args...);
 	}
+
+	//
+	// デフォルトのフォーマッタを使用して
+	// フォーマット化された文字列を断片ごとに返します。
+	//
+	template <typename... Args>
+	_NODISCARD constexpr auto format_chunks(std::string fmt, Args&&... args)
+	{
+		return sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::format_chunks(std::move(fmt), std::forward<Args>(args)...);
+	}
+
+	//
+	// デフォルトのフォーマッタを使用して
+	// フォーマット化されたワイド文字列を断片ごとに返します。
+	//
+	template <typename... Args>
+	_NODISCARD constexpr auto format_chunks(std::wstring fmt, Args&&... args)
+	{
+		return sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::format_chunks(std::move(fmt), std::forward<Args>(args)...);
+	}
+#ifdef _VECTOR_
+	//
+	// std::string型用のフォーマットをプリコンパイルして返します。
+	//
+	_NODISCARD inline auto precompile(const std::string& fmt)
+	{
+		return sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::Compiled(fmt);
+	}
+
+	//
+	// std::wstring型用のフォーマットをプリコンパイルして返します。
+	//
+	_NODISCARD inline auto precompile(const std::wstring& fmt)
+	{
+		return sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::Compiled(fmt);
+	}
+
+	//
+	// デフォルトのフォーマッタとプリコンパイル済みのフォーマットを使用して
+	// フォーマット化された文字列を返します。
+	//
+	template <typename... Args>
+	_NODISCARD constexpr auto format(const sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::Compiled& compiled, Args&&... args) -> std::string
+	{
+		return sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::format(compiled, args...);
+	}
+
+	//
+	// デフォルトのフォーマッタとプリコンパイル済みのフォーマットを使用して
+	// フォーマット化されたワイド文字列を返します。
+	//
+	template <typename... Args>
+	_NODISCARD constexpr auto format(const sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::Compiled& compiled, Args&&... args) -> std::wstring
+	{
+		return sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::format(compiled, args...);
+	}
+
+#ifdef _THREAD_
+	//
+	// デフォルトのフォーマッタとプリコンパイル済みのフォーマットを使用して
+	// 複数のスレッドでフォーマット化された文字列を返します。
+	//
+	template <typename... Args>
+	_NODISCARD inline auto format_parallel(const sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::Compiled& compiled, size_t thread_count, Args&&... args) -> std::string
+	{
+		return sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::format_parallel(compiled, thread_count, args...);
+	}
+
+	//
+	// デフォルトのフォーマッタとプリコンパイル済みのフォーマットを使用して
+	// 複数のスレッドでフォーマット化されたワイド文字列を返します。
+	//
+	template <typename... Args>
+	_NODISCARD inline auto format_parallel(const sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::Compiled& compiled, size_t thread_count, Args&&... args) -> std::wstring
+	{
+		return sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::format_parallel(compiled, thread_count, args...);
+	}
+#endif
+	//
+	// デフォルトのフォーマッタを使用して
+	// 引数を部分的に更新できる書式化結果を返します。
+	//
+	template <typename... Args>
+	_NODISCARD inline auto live_format(const std::string& fmt, Args&&... args)
+	{
+		return sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::Live(fmt, args...);
+	}
+
+	//
+	// デフォルトのフォーマッタを使用して
+	// 引数を部分的に更新できるワイド文字列の書式化結果を返します。
+	//
+	template <typename... Args>
+	_NODISCARD inline auto live_format(const std::wstring& fmt, Args&&... args)
+	{
+		return sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::Live(fmt, args...);
+	}
+#endif
 }
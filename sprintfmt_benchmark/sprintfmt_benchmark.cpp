@@ -0,0 +1,291 @@
+﻿#include <windows.h>
+#include <string>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <iostream>
+#include "../sprintfmt.hpp"
+
+//
+// 指定された処理の1回あたりの所要時間をナノ秒単位で返します。
+//
+template <typename Func>
+double measure(size_t count, Func&& func)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < count; i++)
+		func(i);
+
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+namespace live
+{
+	//
+	// プレースホルダの数を指定して
+	// 全体の書式化と部分更新の所要時間を比較します。
+	// is_fixed_widthがfalseの場合は更新の度に書式化結果の長さが変わります。
+	//
+	void bench(size_t placeholder_count, bool is_fixed_width)
+	{
+		using namespace sprintfmt;
+
+		// 1つ目の引数だけが頻繁に変わり
+		// 残りのプレースホルダは2つ目の引数を参照するフォーマットを作成します。
+		auto fmt = std::string(is_fixed_width ? "counter={/1$08d}" : "counter={/1$}");
+		for (size_t i = 1; i < placeholder_count; i++)
+			fmt += ", label={/2$}";
+
+		const auto label = std::string("hoge");
+		const auto count = 100000 / placeholder_count + 100;
+
+		auto compiled = precompile(fmt);
+		auto live = live_format(fmt, 0, label);
+
+		// 可変幅の場合は桁数が毎回変わる値を使用します。
+		auto get_value = [&](size_t i) {
+			const int values[] = { 9, 10, 100 };
+			return is_fixed_width ? (int)i : values[i % 3];
+		};
+
+		// 最適化で処理が取り除かれないように結果の長さを集計します。
+		size_t total = 0;
+
+		auto full = measure(count, [&](size_t i)
+		{
+			total += format(compiled, get_value(i), label).length();
+		});
+
+		// 長さが変わる場合はstr()で変わったブロックを書式化結果に反映する時間も含まれます。
+		auto partial = measure(count, [&](size_t i)
+		{
+			live.update(1, get_value(i));
+			total += live.str().length();
+		});
+
+		std::cout << format("{/5zu}個({/}): format() {/10.1f}ns, update() {/10.1f}ns, {/6.1f}倍 ({/})",
+			placeholder_count, is_fixed_width ? "固定幅" : "可変幅", full, partial, full / partial, total) << std::endl;
+	}
+
+	//
+	// 部分更新のベンチマークを実行します。
+	//
+	void run()
+	{
+		std::cout << "\033[36m" "部分更新のベンチマークを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		for (auto is_fixed_width : { true, false })
+		{
+			for (auto placeholder_count : { 10, 100, 1000 })
+				bench(placeholder_count, is_fixed_width);
+		}
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "部分更新のベンチマークを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace bytes
+{
+	//
+	// バイト数を指定して
+	// 1バイトずつの書式化とバイト列の書式化の所要時間を比較します。
+	//
+	void bench(size_t size)
+	{
+		using namespace sprintfmt;
+
+		auto data = std::vector<unsigned char>(size);
+		for (size_t i = 0; i < size; i++)
+			data[i] = (unsigned char)(i * 37 + 11);
+
+		const auto span = std::span<const unsigned char>(data);
+		const auto count = 1000000 / size + 100;
+
+		// 最適化で処理が取り除かれないように結果の長さを集計します。
+		size_t total = 0;
+
+		auto per_byte = measure(count, [&](size_t i)
+		{
+			auto s = std::string();
+			for (auto b : data)
+				s += format("{/02X}", b);
+			total += s.length();
+		});
+
+		auto hex = measure(count, [&](size_t i)
+		{
+			total += format("{/}", span).length();
+		});
+
+		auto dump = measure(count, [&](size_t i)
+		{
+			total += format("{/dump}", span).length();
+		});
+
+		std::cout << format("{/6zu}バイト: 1バイトずつ {/10.1f}ns, 16進数 {/10.1f}ns, ダンプ {/10.1f}ns, {/6.1f}倍 ({/})",
+			size, per_byte, hex, dump, per_byte / hex, total) << std::endl;
+	}
+
+	//
+	// バイト列のベンチマークを実行します。
+	//
+	void run()
+	{
+		std::cout << "\033[36m" "バイト列のベンチマークを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		for (auto size : { 16, 256, 4096 })
+			bench(size);
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "バイト列のベンチマークを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace timestamp
+{
+	//
+	// strftime()と書式化を組み合わせたタイムスタンプと
+	// 時刻の書式化の所要時間を比較します。
+	//
+	void run()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "タイムスタンプのベンチマークを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		// 1回毎に1ミリ秒ずつ進めます。
+		const auto start = std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now());
+		const auto count = size_t(1000000);
+
+		// 最適化で処理が取り除かれないように結果の長さを集計します。
+		size_t total = 0;
+
+		auto with_strftime = measure(count, [&](size_t i)
+		{
+			auto time = start + std::chrono::milliseconds(i);
+			auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+			auto t = std::chrono::system_clock::to_time_t(seconds);
+			auto tm = ::tm {};
+			::gmtime_s(&tm, &t);
+			char buffer[32];
+			std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &tm);
+			total += format("{/}.{/03d}Z", buffer, (int)(time - seconds).count()).length();
+		});
+
+		auto with_cache = measure(count, [&](size_t i)
+		{
+			total += format("{/iso.3}", start + std::chrono::milliseconds(i)).length();
+		});
+
+		std::cout << format("strftime() {/10.1f}ns, {/} {/10.1f}ns, {/6.1f}倍 ({/})",
+			with_strftime, "{/iso.3}", with_cache, with_strftime / with_cache, total) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "タイムスタンプのベンチマークを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace parallel
+{
+	//
+	// スレッド数を1からハードウェアのスレッド数まで増やして
+	// 並列フォーマット化の所要時間を比較します。
+	//
+	void run()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "並列フォーマット化のベンチマークを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		// 行毎に幅と精度が異なるプレースホルダを大量に含むフォーマットを作成します。
+		// 引数とサブフォーマットの組み合わせがすべて異なるので、
+		// 文字列化の結果が使い回されずにすべてのプレースホルダが書式化されます。
+		auto fmt = std::string();
+		for (size_t i = 0; i < 2000; i++)
+		{
+			auto spec = std::to_string(i % 50) + "." + std::to_string(i / 50);
+
+			fmt += "row " + std::to_string(i);
+			fmt += ": {/1$" + spec + "d} {/2$" + spec + "f} {/3$" + spec + "X} {/4$" + spec + "s}\n";
+		}
+
+		const auto compiled = precompile(fmt);
+		const auto count = size_t(20);
+
+		// 最適化で処理が取り除かれないように結果の長さを集計します。
+		size_t total = 0;
+
+		auto sequential = measure(count, [&](size_t i)
+		{
+			total += format(compiled, 42, 3.14159, 0xABCDu, "hoge").length();
+		});
+
+		std::cout << format("{/zu}個のトークン: format() {/12.1f}ns", compiled.tokens.size(), sequential) << std::endl;
+
+		auto max_thread_count = (size_t)std::thread::hardware_concurrency();
+		if (!max_thread_count) max_thread_count = 1;
+
+		// スレッド数を2倍ずつ増やして、最後はハードウェアのスレッド数で計測します。
+		for (size_t thread_count = 1; ; thread_count = (thread_count * 2 < max_thread_count) ? thread_count * 2 : max_thread_count)
+		{
+			auto parallel = measure(count, [&](size_t i)
+			{
+				total += format_parallel(compiled, thread_count, 42, 3.14159, 0xABCDu, "hoge").length();
+			});
+
+			std::cout << format("{/3zu}スレッド: format_parallel() {/12.1f}ns, {/6.2f}倍",
+				thread_count, parallel, sequential / parallel) << std::endl;
+
+			if (thread_count >= max_thread_count) break;
+		}
+
+		std::cout << format("({/})", total) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "並列フォーマット化のベンチマークを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+//
+// エントリポイントです。
+//
+int main()
+{
+	// ワイド文字列を使用する場合は
+	// 予めロケールを設定する必要があります。
+	setlocale(LC_CTYPE, "");
+
+	// ベンチマークを開始します。
+	live::run();
+	bytes::run();
+	timestamp::run();
+	parallel::run();
+
+	return 0;
+}
@@ -0,0 +1,761 @@
+﻿#pragma once
+
+namespace sprintfmt
+{
+	//
+	// この列挙型はキャプチャした引数の型です。
+	// fmt_value_append_S()の型の判定と対応しています。
+	//
+	enum class CaptureTag : uint8_t {
+		none,
+		null_pointer,
+		i32, i64,
+		u32, u64,
+		f64,
+		ptr32, ptr64,
+		str, wstr,
+	};
+
+	//
+	// この構造体はキャプチャファイルのヘッダです。
+	//
+	struct CaptureHeader
+	{
+		//
+		// キャプチャファイルの識別子です。
+		//
+		inline static constexpr char c_magic[8] = { 'S', 'P', 'F', 'M', 'T', 'C', 'A', 'P' };
+
+		//
+		// キャプチャファイルのバージョンです。
+		//
+		inline static constexpr uint32_t c_version = 1;
+
+		char magic[8];
+		uint32_t version;
+
+		// キャプチャ時のwchar_tのサイズです。
+		uint32_t wchar_size;
+
+		// フォーマットテーブルの位置と容量と使用量です。
+		uint64_t table_offset;
+		uint64_t table_capacity;
+		volatile LONG64 table_size;
+
+		// レコード領域の位置と容量と使用量です。
+		uint64_t record_offset;
+		uint64_t record_capacity;
+		volatile LONG64 record_size;
+
+		// 容量不足で書き込めなかったレコードの数です。
+		volatile LONG64 dropped_count;
+	};
+
+	//
+	// この構造体はフォーマットテーブルの項目です。
+	// 直後にフォーマットの文字列が続きます。
+	// フォーマットIDはフォーマットテーブル内の項目の位置です。
+	//
+	struct CaptureFormatEntry
+	{
+		uint32_t char_size;
+		uint32_t length;
+	};
+
+	//
+	// この構造体はレコードのヘッダです。
+	// 直後に引数の数(1バイト)と引数が続きます。
+	// 引数は型(1バイト)と値で構成されます。
+	// 値は文字列の場合は長さ(4バイト)と文字列、それ以外の場合は8バイトです。
+	//
+	struct CaptureRecordHeader
+	{
+		// レコード全体のサイズです。
+		// 書き込みが完了するまでは0になっています。
+		volatile LONG size;
+
+		// フォーマットIDです。
+		uint32_t format_id;
+	};
+
+	//
+	// キャプチャできる引数の最大数です。
+	//
+	inline constexpr size_t c_max_capture_arg_count = 16;
+
+	//
+	// 無効なフォーマットIDです。
+	//
+	inline constexpr uint32_t c_invalid_format_id = (uint32_t)-1;
+
+	//
+	// この構造体はキャプチャファイルのマッピングです。
+	//
+	struct CaptureMapping
+	{
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+		uint8_t* view = nullptr;
+		uint64_t view_size = 0;
+
+		//
+		// コンストラクタです。
+		//
+		CaptureMapping() = default;
+
+		//
+		// ハンドルを二重に解放しないようにコピーとムーブを禁止します。
+		//
+		CaptureMapping(const CaptureMapping&) = delete;
+		CaptureMapping& operator=(const CaptureMapping&) = delete;
+		CaptureMapping(CaptureMapping&&) = delete;
+		CaptureMapping& operator=(CaptureMapping&&) = delete;
+
+		//
+		// デストラクタです。
+		//
+		~CaptureMapping()
+		{
+			close();
+		}
+
+		//
+		// ファイルをメモリにマッピングします。
+		// sizeが0の場合は既存のファイルを読み込み専用でマッピングします。
+		//
+		bool open(const std::wstring& path, uint64_t size)
+		{
+			close();
+
+			auto is_write = size != 0;
+
+			file = ::CreateFileW(path.c_str(),
+				is_write ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+				FILE_SHARE_READ, nullptr,
+				is_write ? CREATE_ALWAYS : OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) return false;
+
+			if (!is_write)
+			{
+				auto file_size = LARGE_INTEGER {};
+				if (!::GetFileSizeEx(file, &file_size) || !file_size.QuadPart) return close(), false;
+				size = (uint64_t)file_size.QuadPart;
+			}
+
+			mapping = ::CreateFileMappingW(file, nullptr,
+				is_write ? PAGE_READWRITE : PAGE_READONLY,
+				(DWORD)(size >> 32), (DWORD)size, nullptr);
+			if (!mapping) return close(), false;
+
+			view = (uint8_t*)::MapViewOfFile(mapping,
+				is_write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+			if (!view) return close(), false;
+
+			view_size = size;
+
+			return true;
+		}
+
+		//
+		// マッピングを解除してファイルを閉じます。
+		//
+		void close()
+		{
+			if (view) ::UnmapViewOfFile(view), view = nullptr;
+			if (mapping) ::CloseHandle(mapping), mapping = nullptr;
+			if (file != INVALID_HANDLE_VALUE) ::CloseHandle(file), file = INVALID_HANDLE_VALUE;
+			view_size = 0;
+		}
+	};
+
+	//
+	// この構造体は書式化せずに引数をキャプチャファイルに書き込みます。
+	// キャプチャしたレコードはCaptureReaderで書式化できます。
+	//
+	struct Capture
+	{
+		// キャプチャファイルのマッピングです。
+		CaptureMapping file;
+
+		// キャプチャファイルのヘッダです。
+		CaptureHeader* header = nullptr;
+
+		//
+		// コンストラクタです。
+		//
+		Capture() = default;
+
+		//
+		// マッピングを二重に解放しないようにコピーとムーブを禁止します。
+		//
+		Capture(const Capture&) = delete;
+		Capture& operator=(const Capture&) = delete;
+		Capture(Capture&&) = delete;
+		Capture& operator=(Capture&&) = delete;
+
+		//
+		// 指定されたサイズを8バイト境界に揃えて返します。
+		//
+		inline static constexpr uint64_t align(uint64_t size)
+		{
+			return (size + 7) & ~(uint64_t)7;
+		}
+
+		//
+		// キャプチャファイルを作成します。
+		//
+		bool open(const std::wstring& path, uint64_t table_capacity = 64 * 1024, uint64_t record_capacity = 64 * 1024 * 1024)
+		{
+			close();
+
+			table_capacity = align(table_capacity);
+			record_capacity = align(record_capacity);
+
+			auto table_offset = align(sizeof(CaptureHeader));
+			auto record_offset = table_offset + table_capacity;
+
+			if (!file.open(path, record_offset + record_capacity)) return false;
+
+			header = (CaptureHeader*)file.view;
+			::memcpy(header->magic, CaptureHeader::c_magic, sizeof(header->magic));
+			header->version = CaptureHeader::c_version;
+			header->wchar_size = sizeof(wchar_t);
+			header->table_offset = table_offset;
+			header->table_capacity = table_capacity;
+			header->table_size = 0;
+			header->record_offset = record_offset;
+			header->record_capacity = record_capacity;
+			header->record_size = 0;
+			header->dropped_count = 0;
+
+			return true;
+		}
+
+		//
+		// キャプチャファイルを閉じます。
+		//
+		void close()
+		{
+			if (header) ::FlushViewOfFile(file.view, 0), header = nullptr;
+			file.close();
+		}
+
+		//
+		// フォーマットをテーブルに登録してフォーマットIDを返します。
+		// 呼び出し元でフォーマットIDを保持して使い回してください。
+		//
+		template <typename S>
+		uint32_t register_format_S(const S& fmt)
+		{
+			if (!header) return c_invalid_format_id;
+
+			auto char_size = (uint32_t)sizeof(typename S::value_type);
+			auto size = align(sizeof(CaptureFormatEntry) + fmt.length() * char_size);
+
+			// テーブル内の領域を確保します。
+			auto offset = (uint64_t)::InterlockedExchangeAdd64(&header->table_size, (LONG64)size);
+			if (offset + size > header->table_capacity) return c_invalid_format_id;
+
+			auto entry = (CaptureFormatEntry*)(file.view + header->table_offset + offset);
+			entry->char_size = char_size;
+			entry->length = (uint32_t)fmt.length();
+			std::char_traits<typename S::value_type>::copy(
+				(typename S::value_type*)(entry + 1), fmt.data(), fmt.length());
+
+			return (uint32_t)offset;
+		}
+
+		//
+		// std::string型のフォーマットを登録します。
+		//
+		uint32_t register_format(const std::string& fmt) { return register_format_S(fmt); }
+
+		//
+		// std::wstring型のフォーマットを登録します。
+		//
+		uint32_t register_format(const std::wstring& fmt) { return register_format_S(fmt); }
+
+		//
+		// 値の型を返します。
+		//
+		template <typename T>
+		inline static constexpr auto get_tag(const T& value) -> CaptureTag
+		{
+			if constexpr (std::is_convertible_v<T, const char*>)
+			{
+				if constexpr (std::is_pointer_v<T>)
+					if (!value) return CaptureTag::null_pointer;
+
+				return CaptureTag::str;
+			}
+			else if constexpr (std::is_convertible_v<T, const wchar_t*>)
+			{
+				if constexpr (std::is_pointer_v<T>)
+					if (!value) return CaptureTag::null_pointer;
+
+				return CaptureTag::wstr;
+			}
+			else if constexpr (std::is_same_v<T, std::string>)
+				return CaptureTag::str;
+			else if constexpr (std::is_same_v<T, std::wstring>)
+				return CaptureTag::wstr;
+			else if constexpr (std::is_integral_v<T>)
+			{
+				if constexpr (std::is_signed_v<T>)
+					return sizeof(T) <= 4 ? CaptureTag::i32 : CaptureTag::i64;
+				else
+					return sizeof(T) <= 4 ? CaptureTag::u32 : CaptureTag::u64;
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+				return CaptureTag::f64;
+			else if constexpr (std::is_pointer_v<T> || std::is_enum_v<T>)
+				return sizeof(T) <= 4 ? CaptureTag::ptr32 : CaptureTag::ptr64;
+			else
+				static_assert(std::false_type::value, "この型はキャプチャできません");
+		}
+
+		//
+		// 文字列型の値の先頭と長さを返します。
+		//
+		template <typename T>
+		inline static constexpr auto get_str(const T& value)
+		{
+			if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::wstring>)
+				return std::basic_string_view<typename T::value_type>(value);
+			else if constexpr (std::is_convertible_v<T, const char*>)
+				return std::string_view((const char*)value);
+			else
+				return std::wstring_view((const wchar_t*)value);
+		}
+
+		//
+		// 値の書き込みに必要なサイズを返します。
+		//
+		template <typename T>
+		inline static constexpr uint64_t get_value_size(const T& value)
+		{
+			switch (get_tag(value))
+			{
+			case CaptureTag::null_pointer: return 1;
+			case CaptureTag::str:
+			case CaptureTag::wstr:
+				{
+					if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+						return 0;
+					else
+					{
+						auto str = get_str(value);
+						return 1 + sizeof(uint32_t) + str.length() * sizeof(str[0]);
+					}
+				}
+			}
+
+			return 1 + sizeof(uint64_t);
+		}
+
+		//
+		// 値を書き込み、次の書き込み位置を返します。
+		//
+		template <typename T>
+		inline static uint8_t* write_value(uint8_t* p, const T& value)
+		{
+			auto tag = get_tag(value);
+			*p++ = (uint8_t)tag;
+
+			switch (tag)
+			{
+			case CaptureTag::null_pointer: return p;
+			case CaptureTag::str:
+			case CaptureTag::wstr:
+				{
+					if constexpr (!std::is_arithmetic_v<T> && !std::is_enum_v<T>)
+					{
+						auto str = get_str(value);
+						auto length = (uint32_t)str.length();
+						::memcpy((char*)p, (const char*)&length, sizeof(length));
+						p += sizeof(length);
+						::memcpy((char*)p, (const char*)str.data(), str.length() * sizeof(str[0]));
+						p += str.length() * sizeof(str[0]);
+					}
+
+					return p;
+				}
+			}
+
+			// 値を8バイトに拡張して書き込みます。
+			auto bits = uint64_t {};
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				auto f = (double)value;
+				::memcpy((char*)&bits, (const char*)&f, sizeof(f));
+			}
+			else if constexpr (std::is_pointer_v<T>)
+				bits = (uint64_t)(uintptr_t)value;
+			else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+				bits = (uint64_t)(int64_t)value;
+
+			::memcpy((char*)p, (const char*)&bits, sizeof(bits));
+
+			return p + sizeof(bits);
+		}
+
+		//
+		// 引数を書式化せずにレコードとして書き込みます。
+		// 容量が不足している場合はfalseを返します。
+		//
+		template <typename... Args>
+		bool write(uint32_t format_id, const Args&... args)
+		{
+			static_assert(sizeof...(Args) <= c_max_capture_arg_count, "引数が多すぎます");
+
+			if (!header || format_id == c_invalid_format_id) return false;
+
+			// レコードのサイズを算出します。
+			auto size = align(sizeof(CaptureRecordHeader) + 1 + (get_value_size(args) + ... + 0));
+
+			// レコード領域を確保します。
+			auto offset = (uint64_t)::InterlockedExchangeAdd64(&header->record_size, (LONG64)size);
+			if (offset + size > header->record_capacity)
+			{
+				::InterlockedIncrement64(&header->dropped_count);
+
+				return false;
+			}
+
+			auto record = (CaptureRecordHeader*)(file.view + header->record_offset + offset);
+			record->format_id = format_id;
+
+			// 引数を書き込みます。
+			auto p = (uint8_t*)(record + 1);
+			*p++ = (uint8_t)sizeof...(Args);
+			((p = write_value(p, args)), ...);
+
+			// 最後にサイズを書き込んでレコードを確定します。
+			::InterlockedExchange(&record->size, (LONG)size);
+
+			return true;
+		}
+	};
+
+	//
+	// この構造体はキャプチャした引数です。
+	//
+	struct CapturedValue
+	{
+		CaptureTag tag = CaptureTag::none;
+
+		// 文字列以外の値です。
+		uint64_t bits = 0;
+
+		// 文字列の先頭と長さです。
+		const void* str = nullptr;
+		size_t length = 0;
+	};
+
+	//
+	// この構造体はキャプチャしたレコードです。
+	//
+	struct CapturedRecord
+	{
+		uint32_t format_id = c_invalid_format_id;
+		CapturedValue values[c_max_capture_arg_count];
+		size_t value_count = 0;
+	};
+
+	//
+	// キャプチャした引数を文字列化して追加します。
+	//
+	template <typename S>
+	void fmt_value_append_captured_S(S& out, const S& fmt, const CapturedValue& value, auto... args)
+	{
+		using utils = Utils<S>;
+
+		auto f = double {};
+		::memcpy((char*)&f, (const char*)&value.bits, sizeof(f));
+
+		switch (value.tag)
+		{
+		case CaptureTag::none: out += Helper<S>::keyword.invalid_arg_index; break;
+		case CaptureTag::null_pointer: out += utils::null_pointer; break;
+		case CaptureTag::i32: fmt_value_append(out, fmt, (int32_t)value.bits, args...); break;
+		case CaptureTag::i64: fmt_value_append(out, fmt, (int64_t)value.bits, args...); break;
+		case CaptureTag::u32: fmt_value_append(out, fmt, (uint32_t)value.bits, args...); break;
+		case CaptureTag::u64: fmt_value_append(out, fmt, (uint64_t)value.bits, args...); break;
+		case CaptureTag::f64: fmt_value_append(out, fmt, f, args...); break;
+		case CaptureTag::ptr32:
+			{
+				if (fmt.length())
+					fmt_value_append(out, fmt, (uint32_t)value.bits, args...);
+				else
+					sprintf_append_S(out, utils::fmt_p32, args..., (uint32_t)value.bits);
+				break;
+			}
+		case CaptureTag::ptr64:
+			{
+				if (fmt.length())
+					fmt_value_append(out, fmt, (uint64_t)value.bits, args...);
+				else
+					sprintf_append_S(out, utils::fmt_p64, args..., (uint64_t)value.bits);
+				break;
+			}
+		case CaptureTag::str:
+			{
+				fmt_value_append(out, fmt, std::string((const char*)value.str, value.length), args...);
+				break;
+			}
+		case CaptureTag::wstr:
+			{
+				// レコード内の文字列は境界が揃っていないのでコピーで読み込みます。
+				auto str = std::wstring(value.length, L'\0');
+				::memcpy((char*)str.data(), (const char*)value.str, value.length * sizeof(wchar_t));
+				fmt_value_append(out, fmt, str, args...);
+				break;
+			}
+		}
+	}
+
+	//
+	// キャプチャした引数をstd::stringに変換して追加します。
+	//
+	inline void fmt_value_append(std::string& out, const std::string& fmt, const CapturedValue& value, auto... args)
+	{
+		fmt_value_append_captured_S(out, fmt, value, args...);
+	}
+
+	//
+	// キャプチャした引数をstd::wstringに変換して追加します。
+	//
+	inline void fmt_value_append(std::wstring& out, const std::wstring& fmt, const CapturedValue& value, auto... args)
+	{
+		fmt_value_append_captured_S(out, fmt, value, args...);
+	}
+
+	//
+	// この構造体はキャプチャファイルを読み込んでレコードを書式化します。
+	//
+	struct CaptureReader
+	{
+		// キャプチャファイルのマッピングです。
+		CaptureMapping file;
+
+		// キャプチャファイルのヘッダです。
+		const CaptureHeader* header = nullptr;
+
+		//
+		// コンストラクタです。
+		//
+		CaptureReader() = default;
+
+		//
+		// マッピングを二重に解放しないようにコピーとムーブを禁止します。
+		//
+		CaptureReader(const CaptureReader&) = delete;
+		CaptureReader& operator=(const CaptureReader&) = delete;
+		CaptureReader(CaptureReader&&) = delete;
+		CaptureReader& operator=(CaptureReader&&) = delete;
+
+		//
+		// 指定された位置が8バイト境界に揃っている場合はtrueを返します。
+		// 書き込み側はすべての項目とレコードを8バイト境界に揃えています。
+		//
+		inline static constexpr bool is_aligned(uint64_t offset)
+		{
+			return Capture::align(offset) == offset;
+		}
+
+		//
+		// キャプチャファイルを開きます。
+		//
+		bool open(const std::wstring& path)
+		{
+			close();
+
+			if (!file.open(path, 0)) return false;
+
+			auto h = (const CaptureHeader*)file.view;
+
+			// ヘッダが不正の場合は失敗します。
+			if (file.view_size < sizeof(CaptureHeader) ||
+				::memcmp(h->magic, CaptureHeader::c_magic, sizeof(h->magic)) ||
+				h->version != CaptureHeader::c_version ||
+				!is_aligned(h->table_offset) || !is_aligned(h->record_offset) ||
+				h->table_offset + h->table_capacity > file.view_size ||
+				h->record_offset + h->record_capacity > file.view_size)
+			{
+				return close(), false;
+			}
+
+			header = h;
+
+			return true;
+		}
+
+		//
+		// キャプチャファイルを閉じます。
+		//
+		void close()
+		{
+			header = nullptr;
+			file.close();
+		}
+
+		//
+		// 容量不足で書き込めなかったレコードの数を返します。
+		//
+		uint64_t get_dropped_count() const
+		{
+			return header ? (uint64_t)header->dropped_count : 0;
+		}
+
+		//
+		// フォーマットIDに対応するフォーマットテーブルの項目を返します。
+		//
+		const CaptureFormatEntry* get_format_entry(uint32_t format_id) const
+		{
+			if (!header) return nullptr;
+
+			auto table_size = (uint64_t)header->table_size;
+			if (table_size > header->table_capacity) table_size = header->table_capacity;
+			if ((uint64_t)format_id + sizeof(CaptureFormatEntry) > table_size) return nullptr;
+
+			// 項目の境界ではないフォーマットIDは不正です。
+			if (!is_aligned(format_id)) return nullptr;
+
+			auto entry = (const CaptureFormatEntry*)(file.view + header->table_offset + format_id);
+			if (format_id + sizeof(CaptureFormatEntry) + (uint64_t)entry->length * entry->char_size > table_size) return nullptr;
+
+			return entry;
+		}
+
+		//
+		// フォーマットがワイド文字列の場合はtrueを返します。
+		//
+		bool is_wide_format(uint32_t format_id) const
+		{
+			auto entry = get_format_entry(format_id);
+			return entry && entry->char_size != 1;
+		}
+
+		//
+		// フォーマットを返します。
+		//
+		template <typename S>
+		S get_format(uint32_t format_id) const
+		{
+			auto entry = get_format_entry(format_id);
+			if (!entry || entry->char_size != sizeof(typename S::value_type)) return {};
+
+			// 文字列は境界が揃っていない場合に備えてコピーで読み込みます。
+			auto fmt = S(entry->length, typename S::value_type {});
+			::memcpy((char*)fmt.data(), (const char*)(entry + 1), fmt.length() * sizeof(typename S::value_type));
+			return fmt;
+		}
+
+		//
+		// レコードを読み込み、次のレコードの位置を返します。
+		// 読み込めなかった場合は0を返します。
+		//
+		uint64_t read_record(uint64_t offset, CapturedRecord& record) const
+		{
+			auto record_size = (uint64_t)header->record_size;
+			if (record_size > header->record_capacity) record_size = header->record_capacity;
+			if (offset + sizeof(CaptureRecordHeader) > record_size) return 0;
+
+			auto record_header = (const CaptureRecordHeader*)(file.view + header->record_offset + offset);
+
+			// 書き込みが完了していないレコードの場合は失敗します。
+			auto size = (uint64_t)(uint32_t)record_header->size;
+			if (size <= sizeof(CaptureRecordHeader) || offset + size > record_size) return 0;
+
+			// 8バイト境界に揃っていないサイズは不正です。
+			// 次のレコードのヘッダの境界が揃わなくなるので読み込みを終了します。
+			if (!is_aligned(size)) return 0;
+
+			auto p = (const uint8_t*)(record_header + 1);
+			auto end = (const uint8_t*)record_header + size;
+
+			record.format_id = record_header->format_id;
+			record.value_count = *p++;
+			if (record.value_count > c_max_capture_arg_count) return 0;
+
+			for (size_t i = 0; i < c_max_capture_arg_count; i++)
+			{
+				auto& value = record.values[i];
+				value = {};
+
+				if (i >= record.value_count) continue;
+				if (p >= end) return 0;
+
+				value.tag = (CaptureTag)*p++;
+
+				switch (value.tag)
+				{
+				case CaptureTag::null_pointer: break;
+				case CaptureTag::str:
+				case CaptureTag::wstr:
+					{
+						auto char_size = (uint64_t)(value.tag == CaptureTag::str ? 1 : header->wchar_size);
+						if (value.tag == CaptureTag::wstr && char_size != sizeof(wchar_t)) return 0;
+
+						auto length = uint32_t {};
+						if (p + sizeof(length) > end) return 0;
+						::memcpy((char*)&length, (const char*)p, sizeof(length));
+						p += sizeof(length);
+
+						if (p + length * char_size > end) return 0;
+						value.str = p;
+						value.length = length;
+						p += length * char_size;
+						break;
+					}
+				default:
+					{
+						if (value.tag > CaptureTag::wstr) return 0;
+						if (p + sizeof(value.bits) > end) return 0;
+						::memcpy((char*)&value.bits, (const char*)p, sizeof(value.bits));
+						p += sizeof(value.bits);
+						break;
+					}
+				}
+			}
+
+			return offset + size;
+		}
+
+		//
+		// すべてのレコードを順番に処理します。
+		//
+		template <typename F>
+		void for_each_record(F&& f) const
+		{
+			if (!header) return;
+
+			auto record = CapturedRecord {};
+			for (auto offset = uint64_t {}; (offset = read_record(offset, record)) != 0;)
+				f(record);
+		}
+
+		//
+		// すべての引数を渡して書式化します。
+		// 存在しない引数はCaptureTag::noneとして渡されます。
+		//
+		template <typename S, typename... Values>
+		inline static S format_values(const S& fmt, const CapturedRecord& record, const Values&... values)
+		{
+			if constexpr (sizeof...(Values) == c_max_capture_arg_count)
+				return Formatter<S, MakeSubFormatter<S>>::format(fmt, values...);
+			else
+				return format_values(fmt, record, values..., record.values[sizeof...(Values)]);
+		}
+
+		//
+		// レコードを書式化して返します。
+		//
+		template <typename S>
+		S format(const CapturedRecord& record) const
+		{
+			return format_values(get_format<S>(record.format_id), record);
+		}
+	};
+}
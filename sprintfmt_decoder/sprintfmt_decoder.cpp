@@ -0,0 +1,48 @@
+﻿#include <windows.h>
+#include <string>
+#include <iostream>
+#include "../sprintfmt.hpp"
+#include "../sprintfmt_capture.hpp"
+
+//
+// エントリポイントです。
+// キャプチャファイルのレコードを書式化して標準出力に出力します。
+//
+int main(int argc, char* argv[])
+{
+	// ワイド文字列を使用する場合は
+	// 予めロケールを設定する必要があります。
+	// マルチバイト文字列はキャプチャ時と同じロケールで解釈されます。
+	setlocale(LC_CTYPE, "");
+
+	if (argc < 2)
+	{
+		std::cerr << "使い方: sprintfmt_decoder <キャプチャファイル>" << std::endl;
+
+		return 1;
+	}
+
+	// キャプチャファイルを開きます。
+	auto reader = sprintfmt::CaptureReader {};
+	if (!reader.open(sprintfmt::to_wide(argv[1])))
+	{
+		std::cerr << "キャプチャファイルを開けませんでした: " << argv[1] << std::endl;
+
+		return 1;
+	}
+
+	// すべてのレコードを書式化して出力します。
+	reader.for_each_record([&](const sprintfmt::CapturedRecord& record)
+	{
+		if (reader.is_wide_format(record.format_id))
+			std::wcout << reader.format<std::wstring>(record) << std::endl;
+		else
+			std::cout << reader.format<std::string>(record) << std::endl;
+	});
+
+	// 書き込めなかったレコードが存在する場合は報告します。
+	if (auto dropped_count = reader.get_dropped_count())
+		std::cerr << "容量不足で書き込めなかったレコードがあります: " << dropped_count << std::endl;
+
+	return 0;
+}
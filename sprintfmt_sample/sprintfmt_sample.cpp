@@ -1,6 +1,12 @@
-﻿#include <string>
+﻿#include <windows.h>
+#include <string>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <thread>
 #include <iostream>
 #include "../sprintfmt.hpp"
+#include "../sprintfmt_capture.hpp"
 
 namespace simple
 {
@@ -95,6 +101,21 @@ namespace for_each_type
 		return "ここでHogeを書式化できます";
 	}
 
+	//
+	// この構造体は出力先に直接追加して書式化する型です。
+	//
+	struct Fuga { int id; };
+
+	//
+	// Fugaを文字列化して出力先に直接追加します。
+	// 文字列を作成して返す必要がないので、fmt_value_to_string()よりも高速です。
+	//
+	constexpr void fmt_value_append(std::string& out, const std::string& fmt, const Fuga& value, auto... args)
+	{
+		out += "Fuga#";
+		sprintfmt::fmt_value_append(out, fmt, value.id, args...);
+	}
+
 	//
 	// 型固有書式のテストを実行します。
 	//
@@ -109,6 +130,12 @@ namespace for_each_type
 		std::cout << "ここでHogeを書式化できます" << std::endl;
 		std::cout << format("{/ここでfmtを渡せます}", sfs(Hoge("Hogeのプロパティです"), "ここでargsを渡せます")) << std::endl;
 
+		std::cout << "Fuga#0042, Fuga#7" << std::endl;
+		std::cout << format("{/04d}, {/}", Fuga(42), Fuga(7)) << std::endl;
+
+		std::cout << "Fuga#0042" << std::endl;
+		std::cout << sprintfmt::fmt_value_to_string(std::string("04d"), Fuga(42)) << std::endl;
+
 		std::cout << std::endl;
 
 		std::cout << "\033[36m" "型固有書式のテストを終わります。" "\033[m" << std::endl;
@@ -119,59 +146,52 @@ namespace for_each_type
 
 namespace custom_sub_fmt
 {
-	template <typename S>
-	struct MakeSubFormatter {};
-
 	//
-	// このクラスはstd::string型用のサブフォーマッタ生成関数オブジェクトです。
+	// この構造体は値を16進数で書式化する名前付きサブフォーマットです。
+	// std::stringとstd::wstringの両方で使用されます。
 	//
-	template <>
-	struct MakeSubFormatter<std::string> {
-		template <typename T, typename... Args>
-		constexpr auto operator()(const T& value, Args&&... args) const {
-			return [&](const std::string& fmt)
-			{
-				using namespace sprintfmt;
+	struct Hex {
+		inline static constexpr auto name = "hex";
 
-				if (fmt == "hex")
-					return sprintf(sizeof(value) <= 4 ? "0x%08X" : "0x%016X", value);
+		template <typename S, typename T>
+		void operator()(S& out, const T& value) const
+		requires std::is_integral_v<T>
+		{
+			using namespace sprintfmt;
 
-				if constexpr (std::is_integral_v<T>)
-				{
-					if (fmt == "wordword")
-						return sprintf("0x%04X, 0x%04X", (uint16_t)(value >> 16) , (uint16_t)value);
-				}
-
-				return fmt_value_to_string(fmt, value, args...);
-			};
+			out += from_ascii<S>("0x");
+			fmt_value_append(out, from_ascii<S>(sizeof(value) <= 4 ? "08X" : "016llX"), value);
 		}
 	};
 
 	//
-	// このクラスはstd::wstring型用のサブフォーマッタ生成関数オブジェクトです。
+	// この構造体は整数を上位ワードと下位ワードに分けて書式化する名前付きサブフォーマットです。
 	//
-	template <>
-	struct MakeSubFormatter<std::wstring> {
-		template <typename T, typename... Args>
-		constexpr auto operator()(const T& value, Args&&... args) const {
-			return [&](const std::wstring& fmt)
-			{
-				using namespace sprintfmt;
+	struct WordWord {
+		inline static constexpr auto name = "wordword";
 
-				if (fmt == L"hex")
-					return sprintf(sizeof(value) <= 4 ? L"0x%08X" : L"0x%016X", value);
+		template <typename S, typename T>
+		void operator()(S& out, const T& value) const
+		requires std::is_integral_v<T>
+		{
+			using namespace sprintfmt;
 
-				if constexpr (std::is_integral_v<T>)
-				{
-					if (fmt == L"wordword")
-						return sprintf(L"0x%04X, 0x%04X", (uint16_t)(value >> 16) , (uint16_t)value);
-				}
-
-				return fmt_value_to_string(fmt, value, args...);
-			};
+			sprintf_append_S(out, from_ascii<S>("0x%04X, 0x%04X"), (uint16_t)(value >> 16), (uint16_t)value);
 		}
 	};
 
+	//
+	// 名前付きサブフォーマットのレジストリです。
+	// ここに登録するだけでstd::stringとstd::wstringの両方で使用できます。
+	//
+	using SubFormats = sprintfmt::NamedSubFormats<Hex, WordWord>;
+
+	//
+	// カスタムサブフォーマッタ生成関数オブジェクトです。
+	//
+	template <typename S>
+	using MakeSubFormatter = sprintfmt::MakeNamedSubFormatter<S, SubFormats>;
+
 	//
 	// std::string型用のカスタムフォーマッタを作成して返します。
 	// 少ない文字数でコーディングできるようにするための処理なので、必須の定義ではありません。
@@ -211,6 +231,25 @@ namespace custom_sub_fmt
 		return sprintfmt::Formatter<std::wstring, MakeSubFormatter<std::wstring>>::format(fmt, args...);
 	}
 
+	//
+	// カスタムフォーマッタでフォーマットをプリコンパイルして返します。
+	// 名前付きサブフォーマットはプリコンパイル時に解決されます。
+	//
+	_NODISCARD inline auto precompile(const std::string& fmt)
+	{
+		return sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::Compiled(fmt);
+	}
+
+	//
+	// カスタムフォーマッタとプリコンパイル済みのフォーマットを使用して
+	// フォーマット化された文字列を返します。
+	//
+	template <typename... Args>
+	_NODISCARD constexpr auto format(const sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::Compiled& compiled, Args&&... args) -> std::string
+	{
+		return sprintfmt::Formatter<std::string, MakeSubFormatter<std::string>>::format(compiled, args...);
+	}
+
 	//
 	// カスタムサブフォーマットのテストを実行します。
 	//
@@ -232,6 +271,13 @@ namespace custom_sub_fmt
 		std::wcout << L"0xDEAD, 0xBEEF(ワイド文字列)" << std::endl;
 		std::wcout << format(L"{/wordword}(ワイド文字列)", 0xdeadbeef) << std::endl;
 
+		std::cout << "0x0000ABCD, 0xDEAD, 0xBEEF, 123(プリコンパイル済み)" << std::endl;
+		std::cout << format(precompile("{/hex}, {/wordword}, {/}(プリコンパイル済み)"), 0xabcd, 0xdeadbeef, 123) << std::endl;
+
+		std::cout << "名前付きサブフォーマット以外は通常通り書式化されます。" << std::endl;
+		std::cout << "  1.50, 0042" << std::endl;
+		std::cout << format("{/6.2f}, {/04d}", 1.5, 42) << std::endl;
+
 		std::cout << std::endl;
 
 		std::cout << "\033[36m" "カスタムサブフォーマットのテストを終わります。" "\033[m" << std::endl;
@@ -240,6 +286,408 @@ namespace custom_sub_fmt
 	}
 }
 
+namespace escape
+{
+	//
+	// エスケープのテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "エスケープのテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "CSVの項目としてエスケープします。" << std::endl;
+		std::cout << "123,日本語,\"a,b\",\"\"\"引用\"\"\"" << std::endl;
+		std::cout << format("{/},{/csv},{/csv},{/csv}", 123, "日本語", "a,b", "\"引用\"") << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "TSVの項目としてエスケープします。" << std::endl;
+		std::cout << "a\\tb\tc\\nd\te\\\\f" << std::endl;
+		std::cout << format("{/tsv}\t{/tsv}\t{/tsv}", "a\tb", "c\nd", "e\\f") << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "JSONの文字列としてエスケープします。" << std::endl;
+		std::cout << "{\"name\": \"\\\"表\\\" \\\\ \\n\", \"value\": 123}" << std::endl;
+		std::cout << format("{\"name\": \"{/json}\", \"value\": {/json}}", "\"表\" \\ \n", 123) << std::endl;
+
+		std::wcout << L"{\"name\": \"\\\"表\\\"\"}" << std::endl;
+		std::wcout << format(L"{\"name\": \"{/json}\"}", L"\"表\"") << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "エスケープのテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace chunks
+{
+	//
+	// 断片ごとの書式化のテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "断片ごとの書式化のテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "断片を区切って出力します。" << std::endl;
+		std::cout << "[id=][123][, name=][hoge][, value=0x][0ABC]" << std::endl;
+		for (auto chunk : format_chunks("id={/}, name={/}, value=0x{/04X}", 123, "hoge", 0xABC))
+			std::cout << "[" << chunk << "]";
+		std::cout << std::endl;
+
+		std::cout << "断片を連結するとformat()と同じ文字列になります。" << std::endl;
+		std::cout << format("{/2$}, {/}, {//}", 123, 456, 789) << std::endl;
+		auto s = std::string {};
+		for (auto chunk : format_chunks("{/2$}, {/}, {//}", 123, 456, 789))
+			s += chunk;
+		std::cout << s << std::endl;
+
+		std::cout << "サブフォーマッタも使用できます。" << std::endl;
+		std::cout << "サブフォーマッタが参照する値は断片を取得し終えるまで有効である必要があります。" << std::endl;
+		std::cout << "[value=][   123.457]" << std::endl;
+		auto value = 123.456789; auto width = 10; auto precision = 3;
+		for (auto chunk : format_chunks("value={/*.*f}", sfs(value, width, precision)))
+			std::cout << "[" << chunk << "]";
+		std::cout << std::endl;
+
+		std::wcout << L"[a日b本語][123]" << std::endl;
+		for (auto chunk : format_chunks(L"a日b本語{/}", 123))
+			std::wcout << L"[" << chunk << L"]";
+		std::wcout << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "断片ごとの書式化のテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace precompiled
+{
+	//
+	// この構造体は文字列化の回数を数える型です。
+	//
+	struct Counter { int id; inline static int count = 0; };
+
+	//
+	// Counterを文字列化して出力先に直接追加します。
+	//
+	void fmt_value_append(std::string& out, const std::string& fmt, const Counter& value, auto... args)
+	{
+		Counter::count++;
+		sprintfmt::fmt_value_append(out, fmt, value.id, args...);
+	}
+
+	//
+	// プリコンパイル済みフォーマットのテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "プリコンパイル済みフォーマットのテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "プリコンパイル済みのフォーマットを繰り返し使用します。" << std::endl;
+		std::cout << "1: 0x0ABC, 2: 0x0DEF" << std::endl;
+		auto compiled = precompile("{/}: 0x{/04X}");
+		std::cout << format(compiled, 1, 0xABC) << ", " << format(compiled, 2, 0xDEF) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "同じ引数とサブフォーマットのプレースホルダは一度だけ文字列化されます。" << std::endl;
+		std::cout << "id=42, id=42, id=0042, id=42 (2回)" << std::endl;
+		Counter::count = 0;
+		std::cout << format("id={/1$}, id={/1$}, id={/1$04d}, id={/1$}", Counter(42));
+		std::cout << " (" << Counter::count << "回)" << std::endl;
+		Counter::count = 0;
+		std::cout << format(precompile("id={/1$}, id={/1$}, id={/1$04d}, id={/1$}"), Counter(42));
+		std::cout << " (" << Counter::count << "回)" << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "プリコンパイル済みフォーマットのテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace live
+{
+	//
+	// 部分更新のテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "部分更新のテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "更新した引数を使用しているプレースホルダだけを書式化し直します。" << std::endl;
+		std::cout << "fps=60, frame=0x0100, name=hoge, frame=256" << std::endl;
+		auto live = live_format("fps={/}, frame=0x{/2$04X}, name={/3$}, frame={/2$}", 30, 0, "hoge");
+		live.update(1, 60);
+		live.update(2, 0x100);
+		std::cout << live.str() << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "長さが変わる場合も以降の位置をずらして置き換えます。" << std::endl;
+		std::wcout << L"名前=ふが, 値=12345, 名前=ふが" << std::endl;
+		auto wlive = live_format(L"名前={/}, 値={/}, 名前={/1$}", L"ほげほげ", 1);
+		wlive.update(1, std::wstring(L"ふが"));
+		wlive.update(2, 12345);
+		std::wcout << wlive.str() << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "部分更新のテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace bytes
+{
+	//
+	// バイト列のテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "バイト列のテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		const auto data = std::string("Hello, World!\n\x01\x02");
+		const auto span = std::as_bytes(std::span(data));
+
+		std::cout << "std::spanのバイト列を16進数で出力します。" << std::endl;
+		std::cout << "48656C6C6F2C20576F726C64210A0102, 48 65 6c 6c 6f" << std::endl;
+		std::cout << format("{/}, {/xs}", span, span.first(5)) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "バイト列をBase64で出力します。" << std::endl;
+		std::wcout << L"SGVsbG8sIFdvcmxkIQoBAg==" << std::endl;
+		std::wcout << format(L"{/base64}", span) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "バイト列をダンプします。" << std::endl;
+		std::cout << "00000000  48 65 6c 6c 6f 2c 20 57  6f 72 6c 64 21 0a 01 02  |Hello, World!...|" << std::endl;
+		std::cout << format("{/dump}", span) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "バイト列の16進数を表示幅に揃えます。" << std::endl;
+		std::cout << "[      48656C6C6F]" << std::endl;
+		std::cout << format("[{/w>16}]", span.first(5)) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "バイト列のテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace chrono
+{
+	//
+	// 時刻と経過時間のテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+		using namespace std::chrono;
+
+		std::cout << "\033[36m" "時刻と経過時間のテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		const auto time = sys_days(2026y / 10 / 19) + 12h + 34min + 56s + 789ms;
+
+		std::cout << "時刻をUTCで出力します。" << std::endl;
+		std::cout << "2026-10-19T12:34:56.789Z, 2026-10-19, 12:34:56.789000, 2026-10-19T12:34:56Z" << std::endl;
+		std::cout << format("{/}, {/1$date}, {/1$time.6}, {/1$iso.0}", time) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "ワイド文字列でも出力できます。" << std::endl;
+		std::wcout << L"2026-10-19T12:34:56.78Z" << std::endl;
+		std::wcout << format(L"{/iso.2}", time) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "ローカル時刻を出力します。" << std::endl;
+		std::cout << "2026-10-19T12:34:56.789, [     2026-10-19T12:34:56Z]" << std::endl;
+		std::cout << format("{/}, [{/w>25}]", local_time<milliseconds>(time.time_since_epoch()), floor<seconds>(time)) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "経過時間を出力します。" << std::endl;
+		std::cout << "1500ms, 90min, -01:02:03.005, 42" << std::endl;
+		std::cout << format("{/}, {/}, {/time}, {/lld}", 1500ms, 90min, -(3723s + 5ms), 42s) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "時刻と経過時間のテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace width
+{
+	//
+	// 表示幅のテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "表示幅のテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "全角文字を含む文字列を表示幅で揃えます。" << std::endl;
+		std::cout << "|名前      |     値|" << std::endl;
+		std::cout << "|hoge      |    123|" << std::endl;
+		std::cout << format("|{/w<10}|{/w>7}|", "名前", "値") << std::endl;
+		std::cout << format("|{/w<10}|{/w>7}|", "hoge", 123) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "最大の表示幅を超える場合は文字の境界で切り詰めます。" << std::endl;
+		std::cout << "[日本語テ ] [  あいう  ]" << std::endl;
+		std::cout << format("[{/w<9.9}] [{/w^10}]", "日本語テキスト", "あいう") << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "ワイド文字列も同様に揃えます。" << std::endl;
+		std::wcout << L"[    ｶﾅとかな]" << std::endl;
+		std::wcout << format(L"[{/w>12}]", L"ｶﾅとかな") << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "表示幅のテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace parallel
+{
+	//
+	// 並列フォーマット化のテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "並列フォーマット化のテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		// トークンが多いフォーマットを作成します。
+		auto fmt = std::string();
+		for (size_t i = 0; i < 10000; i++)
+			fmt += "{/1$}:{/2$04X},";
+
+		std::cout << "複数のスレッドでフォーマット化した結果は1つのスレッドの場合と一致します。" << std::endl;
+		std::cout << "true" << std::endl;
+		auto compiled = precompile(fmt);
+		auto result = format(compiled, "hoge", 0xABC);
+		std::cout << std::boolalpha << (format_parallel(compiled, 4, "hoge", 0xABC) == result) << std::endl;
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "並列フォーマット化のテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
+namespace capture
+{
+	//
+	// キャプチャのテストを実行します。
+	//
+	void test()
+	{
+		using namespace sprintfmt;
+
+		std::cout << "\033[36m" "キャプチャのテストを始めます。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+
+		const auto path = std::wstring(L"sprintfmt_sample.capture");
+
+		// 書式化せずに引数をキャプチャします。
+		{
+			auto capture = Capture {};
+			if (!capture.open(path, 4096, 4096))
+			{
+				std::cout << "キャプチャファイルを作成できませんでした。" << std::endl;
+
+				return;
+			}
+
+			auto id1 = capture.register_format("id={/}, name={/}, value=0x{/04X}, rate={/.2f}");
+			auto id2 = capture.register_format(L"{/2$}, {/}, {/}, {/}");
+
+			capture.write(id1, 123, "hoge", 0xABC, 1.5);
+			capture.write(id2, std::wstring(L"a日b本語"), -456, (const char*)nullptr);
+		}
+
+		// キャプチャしたレコードを書式化します。
+		{
+			auto reader = CaptureReader {};
+			if (!reader.open(path))
+			{
+				std::cout << "キャプチャファイルを開けませんでした。" << std::endl;
+
+				return;
+			}
+
+			std::cout << "id=123, name=hoge, value=0x0ABC, rate=1.50" << std::endl;
+			std::cout << "-456, -456, (null), invalid_arg_index" << std::endl;
+
+			reader.for_each_record([&](const CapturedRecord& record)
+			{
+				if (reader.is_wide_format(record.format_id))
+					std::cout << from_wide(reader.format<std::wstring>(record)) << std::endl;
+				else
+					std::cout << reader.format<std::string>(record) << std::endl;
+			});
+		}
+
+		::DeleteFileW(path.c_str());
+
+		std::cout << std::endl;
+
+		std::cout << "\033[36m" "キャプチャのテストを終わります。" "\033[m" << std::endl;
+
+		std::cout << std::endl;
+	}
+}
+
 //
 // エントリポイントです。
 //
@@ -253,6 +701,15 @@ int main()
 	simple::test();
 	for_each_type::test();
 	custom_sub_fmt::test();
+	escape::test();
+	chunks::test();
+	precompiled::test();
+	live::test();
+	bytes::test();
+	chrono::test();
+	width::test();
+	parallel::test();
+	capture::test();
 
 	return 0;
 }